@@ -146,6 +146,9 @@ InputFile::_readFile(std::string inputFileName)
         "-?(?:[0-9]+|[0-9]*.[0-9]+|[0-9]+.[0-9]*)" + e_number_expression + "?");
     // regex to match a numeric value
     std::regex number_regex(initiation + "(" + number_expression + ")" + termination);
+    // regex to match a quoted string value (e.g. an expression such as "sin(x[0]) * t", which may
+    // contain white spaces and any other character but quotes)
+    std::regex quoted_regex(initiation + "\"([^\"]*)\"" + termination);
     std::smatch match;
 
     // while there are newlines to be read
@@ -154,6 +157,16 @@ InputFile::_readFile(std::string inputFileName)
         bool isString = false;
         bool isNumber = false;
 
+        // if the line starts with a quoted string (string parameter)
+        if (std::regex_match(line, match, quoted_regex)) {
+            // assert you were able to find (match) a value and a key
+            assert(match.size() == 3);
+            // store in dictionary (this overwrites an existing pair with the same key)
+            _dictionaryStrings[trim(match[2].str())] = match[1].str();
+            // move on
+            continue;
+        }
+
         // if the line starts with a string (string parameter)
         if (std::regex_match(line, match, string_regex)) {
             // record it is a string
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <map>
+#include <stdexcept>
+#include "../mito/math/Expression.h"
 
 using real = double;
 
@@ -18,6 +20,16 @@ public:
     inline real GetReal(std::string key) const { return _dictionaryReals.at(key); }
     // retrieve string stored in dictionary through its key
     inline std::string GetString(std::string key) const { return _dictionaryStrings.at(key); }
+    // retrieve expression stored in dictionary through its key (e.g. "sin(x[0]) * t"), compiled
+    // for points with D coordinates (throws std::invalid_argument if it is not a valid expression)
+    inline mito::Expression GetExpression(std::string key, int D) const
+    {
+        mito::Expression expression(GetString(key), D);
+        if (!expression.valid()) {
+            throw std::invalid_argument(expression.message());
+        }
+        return expression;
+    }
 
     // private methods
 private:
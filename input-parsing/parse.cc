@@ -33,5 +33,17 @@ main(int argc, char ** argv)
     std::cout << "Kb\t" << Kb << std::endl;
     std::cout << "Nmax\t" << Nmax << std::endl;
 
+    // fields given by expressions of the coordinates and of time, evaluated at a point
+    mito::Expression source = input.GetExpression("source term", 3);
+    mito::Expression traction = input.GetExpression("traction", 3);
+    real x[3] = { 1.0, 2.0, 3.0 };
+    real t = 0.5;
+    real s = 0.0;
+    real h[3] = { 0.0, 0.0, 0.0 };
+    source(x, t, &s, 1);
+    traction(x, t, h, 1);
+    std::cout << "source term\t" << s << std::endl;
+    std::cout << "traction\t" << h[0] << " " << h[1] << " " << h[2] << std::endl;
+
     return 0;
 }
\ No newline at end of file
@@ -93,4 +93,32 @@ YAMLInputFile::Display() const
 
     // all done
     return;
-}
\ No newline at end of file
+}
+mito::Expression
+YAMLInputFile::GetExpression(std::string key, int D) const
+{
+    const YAML::Node & node = _file[key];
+
+    // a scalar expression
+    std::string text;
+    if (!node.IsSequence()) {
+        text = node.as<std::string>();
+    }
+    // a vector expression, read by YAML as a sequence of its components
+    else {
+        text = "[";
+        for (std::size_t i = 0; i < node.size(); ++i) {
+            text += (i == 0 ? "" : ", ") + node[i].as<std::string>();
+        }
+        text += "]";
+    }
+
+    // compile it
+    mito::Expression expression(text, D);
+    if (!expression.valid()) {
+        throw std::invalid_argument(expression.message());
+    }
+
+    // all done
+    return expression;
+}
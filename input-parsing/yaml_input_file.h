@@ -1,6 +1,8 @@
 #include <iostream>
 #include <map>
+#include <stdexcept>
 #include <yaml-cpp/yaml.h>
+#include "../mito/math/Expression.h"
 
 using real = double;
 
@@ -19,6 +21,10 @@ public:
     inline real GetReal(std::string key) const { return _file[key].as<real>(); }
     // retrieve string stored in dictionary through its key
     inline std::string GetString(std::string key) const { return _file[key].as<std::string>(); }
+    // retrieve expression stored in dictionary through its key (e.g. "sin(x[0]) * t", or
+    // [0, -1 * t, x2] for a vector expression), compiled for points with D coordinates (throws
+    // std::invalid_argument if it is not a valid expression)
+    mito::Expression GetExpression(std::string key, int D) const;
 
     // private methods
 private:
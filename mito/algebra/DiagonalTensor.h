@@ -0,0 +1,260 @@
+// code guard
+#if !defined(mito_algebra_DiagonalTensor_h)
+#define mito_algebra_DiagonalTensor_h
+
+#include "../mito.h"
+#include "SymmetricTensor.h"
+
+namespace mito {
+
+    /**
+     * A diagonal tensor of dimension D, storing only its D diagonal entries.
+     */
+    template <int D, typename T = real>
+    class DiagonalTensor {
+
+      public:
+        // the number of indices
+        static constexpr int N = 2;
+        // the number of independent entries (size of the container)
+        static constexpr int S = D;
+        // store the underlying type
+        using type = T;
+        // the full tensor type
+        using tensor_type = tensor_t<D, D, T>;
+        // the packed storage type
+        using storage_type = vector_t<S, T>;
+
+      public:
+        // default constructor (all entries are value-initialized)
+        constexpr DiagonalTensor() : _data {} {}
+
+        // constructor from the diagonal entries
+        template <class... T2, typename std::enable_if<sizeof...(T2) == S, int>::type = 0>
+        constexpr DiagonalTensor(T2... args) : _data { static_cast<T>(args)... }
+        {}
+
+        // constructor from the diagonal entries
+        explicit constexpr DiagonalTensor(const storage_type & data) : _data(data) {}
+
+        // constructor from the diagonal of a full tensor
+        explicit constexpr DiagonalTensor(const tensor_type & A) : _data {}
+        {
+            for (int i = 0; i < D; ++i) {
+                _data[i] = A[i * D + i];
+            }
+
+            // all done
+            return;
+        }
+
+      public:
+        // accessor to diagonal entry {i}
+        constexpr const T & operator[](int i) const { return _data[i]; }
+        // mutator to diagonal entry {i}
+        constexpr T & operator[](int i) { return _data[i]; }
+
+        // accessor to entry {i, j}
+        constexpr T operator()(int i, int j) const { return i == j ? _data[i] : T(0); }
+
+        // accessor to the diagonal entries
+        constexpr const storage_type & data() const { return _data; }
+
+        // conversion to a full tensor
+        constexpr operator tensor_type() const
+        {
+            tensor_type A;
+            for (int i = 0; i < D; ++i) {
+                A[i * D + i] = _data[i];
+            }
+            return A;
+        }
+
+        // conversion to a symmetric tensor
+        constexpr operator SymmetricTensor<D, T>() const
+        {
+            SymmetricTensor<D, T> A;
+            for (int i = 0; i < D; ++i) {
+                A(i, i) = _data[i];
+            }
+            return A;
+        }
+
+        constexpr void operator+=(const DiagonalTensor & rhs)
+        {
+            // entry-wise operator+=
+            _data += rhs._data;
+
+            // all done
+            return;
+        }
+
+        // reset to zero
+        constexpr void reset()
+        {
+            // reset to zero all entries
+            _data.reset();
+
+            // all done
+            return;
+        }
+
+      private:
+        // data (the diagonal)
+        storage_type _data;
+    };
+
+    // typedef for diagonal tensors
+    template <int D, typename T = real>
+    using diag_tensor_t = DiagonalTensor<D, T>;
+
+    // sum of diagonal tensors
+    template <int D, typename T>
+    constexpr auto operator+(const DiagonalTensor<D, T> & A, const DiagonalTensor<D, T> & B)
+    {
+        return DiagonalTensor<D, T>(
+            typename DiagonalTensor<D, T>::storage_type(A.data() + B.data()));
+    }
+
+    // difference of diagonal tensors
+    template <int D, typename T>
+    constexpr auto operator-(const DiagonalTensor<D, T> & A, const DiagonalTensor<D, T> & B)
+    {
+        return DiagonalTensor<D, T>(
+            typename DiagonalTensor<D, T>::storage_type(A.data() - B.data()));
+    }
+
+    // diagonal tensor times scalar
+    template <int D, typename T>
+    constexpr auto operator*(const std::type_identity_t<T> & a, const DiagonalTensor<D, T> & A)
+    {
+        return DiagonalTensor<D, T>(typename DiagonalTensor<D, T>::storage_type(a * A.data()));
+    }
+    template <int D, typename T>
+    constexpr auto operator*(const DiagonalTensor<D, T> & A, const std::type_identity_t<T> & a)
+    {
+        return a * A;
+    }
+
+    // helper function: entry-wise product of the diagonals
+    template <int D, typename T, size_t... I>
+    constexpr auto _diagonal_times(
+        const DiagonalTensor<D, T> & A, const vector_t<D, T> & x, std::index_sequence<I...>)
+    {
+        return vector_t<D, T> { (A[I] * x[I])... };
+    }
+
+    // diagonal tensor times vector
+    template <int D, typename T>
+    constexpr auto operator*(const DiagonalTensor<D, T> & A, const vector_t<D, T> & x)
+    {
+        return _diagonal_times(A, x, std::make_index_sequence<D> {});
+    }
+
+    // matrix product of diagonal tensors
+    template <int D, typename T>
+    constexpr auto dot(const DiagonalTensor<D, T> & A, const DiagonalTensor<D, T> & B)
+    {
+        return DiagonalTensor<D, T>(_diagonal_times(A, B.data(), std::make_index_sequence<D> {}));
+    }
+
+    // matrix product of a diagonal tensor and a tensor (scales the rows)
+    template <int D, typename T>
+    constexpr auto dot(const DiagonalTensor<D, T> & A, const tensor_t<D, D, T> & B)
+    {
+        tensor_t<D, D, T> C;
+        for (int i = 0; i < D; ++i) {
+            for (int j = 0; j < D; ++j) {
+                C[i * D + j] = A[i] * B[i * D + j];
+            }
+        }
+        return C;
+    }
+
+    // matrix product of a tensor and a diagonal tensor (scales the columns)
+    template <int D, typename T>
+    constexpr auto dot(const tensor_t<D, D, T> & A, const DiagonalTensor<D, T> & B)
+    {
+        tensor_t<D, D, T> C;
+        for (int i = 0; i < D; ++i) {
+            for (int j = 0; j < D; ++j) {
+                C[i * D + j] = A[i * D + j] * B[j];
+            }
+        }
+        return C;
+    }
+
+    // helper function: sum of the diagonal entries
+    template <int D, typename T, size_t... I>
+    constexpr T _trace(const DiagonalTensor<D, T> & A, std::index_sequence<I...>)
+    {
+        return (A[I] + ...);
+    }
+
+    // trace of a diagonal tensor
+    template <int D, typename T>
+    constexpr T ComputeTrace(const DiagonalTensor<D, T> & A)
+    {
+        return _trace(A, std::make_index_sequence<D> {});
+    }
+
+    // helper function: product of the diagonal entries
+    template <int D, typename T, size_t... I>
+    constexpr T _determinant(const DiagonalTensor<D, T> & A, std::index_sequence<I...>)
+    {
+        return (A[I] * ...);
+    }
+
+    // determinant of a diagonal tensor
+    template <int D, typename T>
+    constexpr T ComputeDeterminant(const DiagonalTensor<D, T> & A)
+    {
+        return _determinant(A, std::make_index_sequence<D> {});
+    }
+
+    // inverse of a diagonal tensor (returns the determinant)
+    template <int D, typename T>
+    constexpr T ComputeInverse(const DiagonalTensor<D, T> & A, DiagonalTensor<D, T> & invA)
+    {
+        T det = ComputeDeterminant(A);
+        assert(det != T(0));
+
+        for (int i = 0; i < D; ++i) {
+            invA[i] = T(1) / A[i];
+        }
+
+        return det;
+    }
+
+    // helper function: double contraction with a diagonal tensor (only the diagonal of the other
+    // tensor contributes)
+    template <int D, typename T, class B, size_t... I>
+    constexpr T _ddot(const DiagonalTensor<D, T> & A, const B & b, std::index_sequence<I...>)
+    {
+        return ((A[I] * b(I, I)) + ...);
+    }
+
+    // double contraction A:B of diagonal tensors
+    template <int D, typename T>
+    constexpr T ddot(const DiagonalTensor<D, T> & A, const DiagonalTensor<D, T> & B)
+    {
+        return _ddot(A, B, std::make_index_sequence<D> {});
+    }
+
+    // double contraction A:B of a diagonal and a symmetric tensor
+    template <int D, typename T>
+    constexpr T ddot(const DiagonalTensor<D, T> & A, const SymmetricTensor<D, T> & B)
+    {
+        return _ddot(A, B, std::make_index_sequence<D> {});
+    }
+    template <int D, typename T>
+    constexpr T ddot(const SymmetricTensor<D, T> & A, const DiagonalTensor<D, T> & B)
+    {
+        return ddot(B, A);
+    }
+
+}    // namespace mito
+
+#endif    // mito_algebra_DiagonalTensor_h
+
+// end of file
@@ -1,4 +1,11 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 #include <valarray>
+#include "expressions.h"
 
 namespace mito {
 
@@ -8,6 +15,17 @@ namespace mito {
         return (args * ...);
     }
 
+    // the largest power of two dividing {bytes}, capped at {cap}: aligning a grid to this boundary
+    // never pads it, so arrays of grids stay densely packed
+    constexpr std::size_t grid_alignment(std::size_t bytes, std::size_t cap = 64)
+    {
+        std::size_t align = 1;
+        while (align < cap && bytes % (2 * align) == 0) {
+            align *= 2;
+        }
+        return align;
+    }
+
     template <typename T, int... I>
     class SmallGrid {
 
@@ -16,50 +34,96 @@ namespace mito {
         static constexpr int N = sizeof...(I);
         // compute the number of cells (size of the container)
         static constexpr int S = multiply(I...);
+        // the extent of each index
+        static constexpr std::array<int, N> shape = { I... };
         // store the underlying type
         using type = T;
+        // a grid evaluates to itself
+        using grid_type = SmallGrid;
+
+      private:
+        // the alignment of the storage
+        static constexpr std::size_t _alignment =
+            std::max(alignof(T), grid_alignment(S * sizeof(T) /* bytes */));
 
       public:
-        // default constructor
-        inline SmallGrid() : _data(S) {}
+        // default constructor (all entries are value-initialized)
+        constexpr SmallGrid() : _data {} {}
 
         // constructor with valarray
-        inline SmallGrid(const std::valarray<T> & data) : _data(data) {}
+        inline SmallGrid(const std::valarray<T> & data) : _data {}
+        {
+            // assert the valarray has the same number of cells as the grid
+            assert(data.size() == S);
+
+            // copy the entries of the valarray
+            _copy(std::make_index_sequence<S> {}, data);
+
+            // all done
+            return;
+        }
 
         // constructor from brace-enclosed initializer list
         template <class... T2, typename std::enable_if<sizeof...(T2) == S, int>::type = 0>
-        SmallGrid(T2... args) : SmallGrid()
+        constexpr SmallGrid(T2... args) : _data { static_cast<T>(args)... }
+        {}
+
+        // constructor from an expression evaluating to this type of grid
+        template <class E>
+        constexpr SmallGrid(const E & expression) requires(expression_of<E, SmallGrid>) : _data {}
         {
-            // initialize with input arguments
-            _initialize(std::make_index_sequence<S> {}, args...);
+            // evaluate the expression entry by entry
+            _assign(std::make_index_sequence<S> {}, expression);
+
+            // all done
+            return;
+        }
+
+        // conversion from a grid of the same shape with a different underlying type (e.g. double
+        // to float)
+        template <typename T2>
+        explicit constexpr SmallGrid(const SmallGrid<T2, I...> & grid) requires(
+            !std::is_same_v<T2, T>) :
+            _data {}
+        {
+            // convert entry by entry
+            _assign(std::make_index_sequence<S> {}, grid);
 
             // all done
             return;
         }
 
         // copy constructor
-        SmallGrid(const SmallGrid &) = default;
+        constexpr SmallGrid(const SmallGrid &) = default;
 
         // move constructor
-        SmallGrid(SmallGrid &&) = default;
+        constexpr SmallGrid(SmallGrid &&) = default;
 
         // copy assignment operator
-        SmallGrid & operator=(const SmallGrid &) = default;
+        constexpr SmallGrid & operator=(const SmallGrid &) = default;
 
         // move assignment operator
-        SmallGrid & operator=(SmallGrid &&) = default;
+        constexpr SmallGrid & operator=(SmallGrid &&) = default;
+
+        // assignment from an expression evaluating to this type of grid
+        template <class E>
+        constexpr SmallGrid & operator=(const E & expression) requires(expression_of<E, SmallGrid>)
+        {
+            // evaluate the expression in a new grid first, as it may reference this grid
+            return *this = SmallGrid(expression);
+        }
 
         // destructor
-        inline ~SmallGrid() {}
+        constexpr ~SmallGrid() = default;
 
       public:
         // inline const T & operator[](index_t i) const { return _grid[i]; }
         // inline T & operator[](index_t i) { return _grid[i]; }
 
-        inline const T & operator[](int i) const { return _data[i]; }
-        inline T & operator[](int i) { return _data[i]; }
+        constexpr const T & operator[](int i) const { return _data[i]; }
+        constexpr T & operator[](int i) { return _data[i]; }
 
-        inline void operator+=(const SmallGrid<T, I...> & rhs)
+        constexpr void operator+=(const SmallGrid<T, I...> & rhs)
         {
             // component-wise operator+=
             _operatorPlusEqual(std::make_index_sequence<S> {}, rhs);
@@ -68,14 +132,21 @@ namespace mito {
             return;
         }
 
+        template <class E>
+        constexpr void operator+=(const E & rhs) requires(expression_of<E, SmallGrid>)
+        {
+            // evaluate the expression in a new grid first, as it may reference this grid
+            return operator+=(SmallGrid(rhs));
+        }
+
         // enable cast to underlying type if S = 1 (scalar grid)
-        operator T() const requires(S == 1) { return _data[0]; }
+        constexpr operator T() const requires(S == 1) { return _data[0]; }
 
         // enable cast to valarray
-        operator std::valarray<T>() const { return _data; }
+        operator std::valarray<T>() const { return std::valarray<T>(_data.data(), S); }
 
         // reset to zero
-        inline void reset()
+        constexpr void reset()
         {
             // reset to zero all entries
             _reset(std::make_index_sequence<S> {});
@@ -85,20 +156,26 @@ namespace mito {
         }
 
       private:
-        template <size_t... J, class... T2>
-        void _initialize(std::index_sequence<J...>, T2... args)
+        template <size_t... J>
+        void _copy(std::index_sequence<J...>, const std::valarray<T> & data)
+        {
+            ((_data[J] = data[J]), ...);
+        }
+
+        template <size_t... J, class E>
+        constexpr void _assign(std::index_sequence<J...>, const E & expression)
         {
-            ((_data[J] = args), ...);
+            ((_data[J] = static_cast<T>(expression[J])), ...);
         }
 
         template <size_t... J>
-        void _reset(std::index_sequence<J...>)
+        constexpr void _reset(std::index_sequence<J...>)
         {
             ((_data[J] = T()), ...);
         }
 
         template <size_t... J>
-        void _operatorPlusEqual(std::index_sequence<J...>, const SmallGrid<T, I...> & rhs)
+        constexpr void _operatorPlusEqual(std::index_sequence<J...>, const SmallGrid<T, I...> & rhs)
         {
             ((_data[J] += rhs[J]), ...);
         }
@@ -107,8 +184,8 @@ namespace mito {
         constexpr auto size() { return S; }
 
       private:
-        // data
-        std::valarray<T> _data;
+        // data (stored inline, so grids are trivially copyable and never touch the heap)
+        alignas(_alignment) std::array<T, S> _data;
     };
 
 }    // namespace mito
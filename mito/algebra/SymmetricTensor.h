@@ -0,0 +1,334 @@
+// code guard
+#if !defined(mito_algebra_SymmetricTensor_h)
+#define mito_algebra_SymmetricTensor_h
+
+#include "../mito.h"
+
+namespace mito {
+
+    /**
+     * A symmetric tensor of dimension D, storing only the D(D+1)/2 entries of its upper triangle,
+     *   row by row (e.g. {A00, A01, A02, A11, A12, A22} in 3D). Its kernels below (contractions,
+     *   trace, determinant, inverse, double contraction) only visit the independent entries.
+     */
+    template <int D, typename T = real>
+    class SymmetricTensor {
+
+      public:
+        // the number of indices
+        static constexpr int N = 2;
+        // the number of independent entries (size of the container)
+        static constexpr int S = D * (D + 1) / 2;
+        // store the underlying type
+        using type = T;
+        // the full tensor type
+        using tensor_type = tensor_t<D, D, T>;
+        // the packed storage type
+        using storage_type = vector_t<S, T>;
+
+      public:
+        // the position of entry {i, j} in the packed storage
+        static constexpr int index(int i, int j)
+        {
+            return i <= j ? i * D - i * (i - 1) / 2 + j - i : index(j, i);
+        }
+
+        // whether entry {k} of the packed storage lies on the diagonal
+        static constexpr bool diagonal(int k)
+        {
+            for (int i = 0; i < D; ++i) {
+                if (index(i, i) == k) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+      public:
+        // default constructor (all entries are value-initialized)
+        constexpr SymmetricTensor() : _data {} {}
+
+        // constructor from the packed entries
+        template <class... T2, typename std::enable_if<sizeof...(T2) == S, int>::type = 0>
+        constexpr SymmetricTensor(T2... args) : _data { static_cast<T>(args)... }
+        {}
+
+        // constructor from the packed storage
+        explicit constexpr SymmetricTensor(const storage_type & data) : _data(data) {}
+
+        // constructor from the symmetric part of a full tensor
+        explicit constexpr SymmetricTensor(const tensor_type & A) : _data {}
+        {
+            for (int i = 0; i < D; ++i) {
+                for (int j = i; j < D; ++j) {
+                    _data[index(i, j)] = 0.5 * (A[i * D + j] + A[j * D + i]);
+                }
+            }
+
+            // all done
+            return;
+        }
+
+      public:
+        // accessor to entry {k} of the packed storage
+        constexpr const T & operator[](int k) const { return _data[k]; }
+        // mutator to entry {k} of the packed storage
+        constexpr T & operator[](int k) { return _data[k]; }
+
+        // accessor to entry {i, j}
+        constexpr const T & operator()(int i, int j) const { return _data[index(i, j)]; }
+        // mutator to entry {i, j} (and {j, i})
+        constexpr T & operator()(int i, int j) { return _data[index(i, j)]; }
+
+        // accessor to the packed storage
+        constexpr const storage_type & data() const { return _data; }
+
+        // conversion to a full tensor
+        constexpr operator tensor_type() const
+        {
+            tensor_type A;
+            for (int i = 0; i < D; ++i) {
+                for (int j = 0; j < D; ++j) {
+                    A[i * D + j] = _data[index(i, j)];
+                }
+            }
+            return A;
+        }
+
+        constexpr void operator+=(const SymmetricTensor & rhs)
+        {
+            // entry-wise operator+=
+            _data += rhs._data;
+
+            // all done
+            return;
+        }
+
+        // reset to zero
+        constexpr void reset()
+        {
+            // reset to zero all entries
+            _data.reset();
+
+            // all done
+            return;
+        }
+
+      private:
+        // data (upper triangle, row by row)
+        storage_type _data;
+    };
+
+    // typedef for symmetric tensors
+    template <int D, typename T = real>
+    using sym_tensor_t = SymmetricTensor<D, T>;
+
+    // sum of symmetric tensors
+    template <int D, typename T>
+    constexpr auto operator+(const SymmetricTensor<D, T> & A, const SymmetricTensor<D, T> & B)
+    {
+        return SymmetricTensor<D, T>(typename SymmetricTensor<D, T>::storage_type(
+            A.data() + B.data()));
+    }
+
+    // difference of symmetric tensors
+    template <int D, typename T>
+    constexpr auto operator-(const SymmetricTensor<D, T> & A, const SymmetricTensor<D, T> & B)
+    {
+        return SymmetricTensor<D, T>(typename SymmetricTensor<D, T>::storage_type(
+            A.data() - B.data()));
+    }
+
+    // symmetric tensor times scalar
+    template <int D, typename T>
+    constexpr auto operator*(const std::type_identity_t<T> & a, const SymmetricTensor<D, T> & A)
+    {
+        return SymmetricTensor<D, T>(typename SymmetricTensor<D, T>::storage_type(a * A.data()));
+    }
+    template <int D, typename T>
+    constexpr auto operator*(const SymmetricTensor<D, T> & A, const std::type_identity_t<T> & a)
+    {
+        return a * A;
+    }
+
+    // helper function: row {I} of a symmetric tensor times a vector, with J over the columns
+    template <int I, int D, typename T, class X, size_t... J>
+    constexpr T _row_times(
+        const SymmetricTensor<D, T> & A, const X & x, std::index_sequence<J...>)
+    {
+        return ((A[SymmetricTensor<D, T>::index(I, J)] * x[J]) + ...);
+    }
+
+    // helper function: symmetric tensor times vector, with I over the rows
+    template <int D, typename T, size_t... I>
+    constexpr auto _symmetric_times(
+        const SymmetricTensor<D, T> & A, const vector_t<D, T> & x, std::index_sequence<I...>)
+    {
+        return vector_t<D, T> { _row_times<I>(A, x, std::make_index_sequence<D> {})... };
+    }
+
+    // symmetric tensor times vector
+    template <int D, typename T>
+    constexpr auto operator*(const SymmetricTensor<D, T> & A, const vector_t<D, T> & x)
+    {
+        return _symmetric_times(A, x, std::make_index_sequence<D> {});
+    }
+
+    // helper function: column {J} of a symmetric tensor (as a vector)
+    template <int J, int D, typename T, size_t... I>
+    constexpr auto _column(const SymmetricTensor<D, T> & B, std::index_sequence<I...>)
+    {
+        return vector_t<D, T> { B[SymmetricTensor<D, T>::index(I, J)]... };
+    }
+
+    // helper function: column {J} of the product of symmetric tensors
+    template <int J, int D, typename T, size_t... I>
+    constexpr void _product_column(
+        const SymmetricTensor<D, T> & A, const SymmetricTensor<D, T> & B, tensor_t<D, D, T> & C,
+        std::index_sequence<I...>)
+    {
+        const vector_t<D, T> column = A * _column<J>(B, std::make_index_sequence<D> {});
+        ((C[I * D + J] = column[I]), ...);
+        return;
+    }
+
+    // helper function: product of symmetric tensors, with J over the columns
+    template <int D, typename T, size_t... J>
+    constexpr void _product(
+        const SymmetricTensor<D, T> & A, const SymmetricTensor<D, T> & B, tensor_t<D, D, T> & C,
+        std::index_sequence<J...>)
+    {
+        ((_product_column<J>(A, B, C, std::make_index_sequence<D> {})), ...);
+        return;
+    }
+
+    // matrix product of symmetric tensors (not symmetric in general)
+    template <int D, typename T>
+    constexpr auto dot(const SymmetricTensor<D, T> & A, const SymmetricTensor<D, T> & B)
+    {
+        tensor_t<D, D, T> C;
+        _product(A, B, C, std::make_index_sequence<D> {});
+        return C;
+    }
+
+    // C = F^T F: the symmetric product of a tensor with itself (only the upper triangle is
+    // computed)
+    template <int D, typename T>
+    constexpr void ComputeTransposeProduct(const tensor_t<D, D, T> & F, SymmetricTensor<D, T> & C)
+    {
+        for (int i = 0; i < D; ++i) {
+            for (int j = i; j < D; ++j) {
+                T Cij = F[i] * F[j];
+                for (int k = 1; k < D; ++k) {
+                    Cij += F[k * D + i] * F[k * D + j];
+                }
+                C(i, j) = Cij;
+            }
+        }
+
+        // all done
+        return;
+    }
+
+    // helper function: trace of a symmetric tensor
+    template <int D, typename T, size_t... I>
+    constexpr T _trace(const SymmetricTensor<D, T> & A, std::index_sequence<I...>)
+    {
+        return (A(I, I) + ...);
+    }
+
+    // trace of a symmetric tensor
+    template <int D, typename T>
+    constexpr T ComputeTrace(const SymmetricTensor<D, T> & A)
+    {
+        return _trace(A, std::make_index_sequence<D> {});
+    }
+
+    // helper function: double contraction of symmetric tensors (off-diagonal entries count twice)
+    template <int D, typename T, size_t... K>
+    constexpr T _ddot(
+        const SymmetricTensor<D, T> & A, const SymmetricTensor<D, T> & B,
+        std::index_sequence<K...>)
+    {
+        return (((SymmetricTensor<D, T>::diagonal(K) ? T(1) : T(2)) * A[K] * B[K]) + ...);
+    }
+
+    // double contraction A:B of symmetric tensors
+    template <int D, typename T>
+    constexpr T ddot(const SymmetricTensor<D, T> & A, const SymmetricTensor<D, T> & B)
+    {
+        return _ddot(A, B, std::make_index_sequence<SymmetricTensor<D, T>::S> {});
+    }
+
+    // closed forms of the determinant and of the inverse of small symmetric tensors
+    template <typename T>
+    constexpr T ComputeDeterminant(const SymmetricTensor<2, T> & A)
+    {
+        return A[0] * A[2] - A[1] * A[1];
+    }
+
+    template <typename T>
+    constexpr T ComputeDeterminant(const SymmetricTensor<3, T> & A)
+    {
+        return A[0] * (A[3] * A[5] - A[4] * A[4]) - A[1] * (A[1] * A[5] - A[4] * A[2])
+             + A[2] * (A[1] * A[4] - A[3] * A[2]);
+    }
+
+    // determinant of a symmetric tensor of any other dimension
+    template <int D, typename T>
+    constexpr T ComputeDeterminant(const SymmetricTensor<D, T> & A)
+    {
+        return ComputeDeterminant<D, T>(tensor_t<D, D, T>(A));
+    }
+
+    template <typename T>
+    constexpr T ComputeInverse(const SymmetricTensor<2, T> & A, SymmetricTensor<2, T> & invA)
+    {
+        T det = ComputeDeterminant(A);
+        assert(det != T(0));
+
+        T detinv = T(1) / det;
+        invA[0] = detinv * (A[2]);
+        invA[1] = detinv * (-A[1]);
+        invA[2] = detinv * (A[0]);
+
+        return det;
+    }
+
+    template <typename T>
+    constexpr T ComputeInverse(const SymmetricTensor<3, T> & A, SymmetricTensor<3, T> & invA)
+    {
+        // the cofactors
+        T C00 = A[3] * A[5] - A[4] * A[4];
+        T C01 = A[2] * A[4] - A[1] * A[5];
+        T C02 = A[1] * A[4] - A[2] * A[3];
+
+        T det = A[0] * C00 + A[1] * C01 + A[2] * C02;
+        assert(det != T(0));
+
+        T detinv = T(1) / det;
+        invA[0] = detinv * C00;
+        invA[1] = detinv * C01;
+        invA[2] = detinv * C02;
+        invA[3] = detinv * (A[0] * A[5] - A[2] * A[2]);
+        invA[4] = detinv * (A[1] * A[2] - A[0] * A[4]);
+        invA[5] = detinv * (A[0] * A[3] - A[1] * A[1]);
+
+        return det;
+    }
+
+    // inverse of a symmetric tensor of any other dimension (returns the determinant)
+    template <int D, typename T>
+    constexpr T ComputeInverse(const SymmetricTensor<D, T> & A, SymmetricTensor<D, T> & invA)
+    {
+        tensor_t<D, D, T> inverse;
+        T det = ComputeInverse<D, T>(tensor_t<D, D, T>(A), inverse);
+        invA = SymmetricTensor<D, T>(inverse);
+        return det;
+    }
+
+}    // namespace mito
+
+#endif    // mito_algebra_SymmetricTensor_h
+
+// end of file
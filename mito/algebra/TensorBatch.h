@@ -0,0 +1,240 @@
+// code guard
+#if !defined(mito_algebra_TensorBatch_h)
+#define mito_algebra_TensorBatch_h
+
+#include "../mito.h"
+#include "simd.h"
+
+namespace mito {
+
+    /**
+     * A batch of N tensors of shape D1 x D2 stored as a structure of arrays: the N values of each
+     *   component are contiguous, so the batched kernels below process a SIMD pack of tensors per
+     *   instruction. The storage is inline, so N is meant to be a tile of a few SIMD widths and
+     *   large collections are arrays of batches (an array of structures of arrays).
+     */
+    template <int D1, int D2, int N, typename T = real>
+    class TensorBatch {
+
+      public:
+        // the number of components of each tensor
+        static constexpr int S = D1 * D2;
+        // the number of tensors in the batch
+        static constexpr int size = N;
+        // store the underlying type
+        using type = T;
+        // the type of each tensor in the batch
+        using tensor_type = std::conditional_t<
+            D1 == 1 && D2 == 1, scalar_t<T>,
+            std::conditional_t<D2 == 1, vector_t<D1, T>, tensor_t<D1, D2, T>>>;
+
+      public:
+        // default constructor (all entries are value-initialized)
+        inline TensorBatch() : _data {} {}
+
+      public:
+        // mutator to the contiguous values of component {k} of all tensors
+        inline T * component(int k) { return _data.data() + k * N; }
+        // accessor to the contiguous values of component {k} of all tensors
+        inline const T * component(int k) const { return _data.data() + k * N; }
+
+        // mutator to component {k} of tensor {n}
+        inline T & operator()(int n, int k) { return _data[k * N + n]; }
+        // accessor to component {k} of tensor {n}
+        inline const T & operator()(int n, int k) const { return _data[k * N + n]; }
+
+        // gather tensor {n} of the batch
+        inline tensor_type get(int n) const
+        {
+            tensor_type tensor;
+            for (int k = 0; k < S; ++k) {
+                tensor[k] = _data[k * N + n];
+            }
+            return tensor;
+        }
+
+        // scatter {tensor} to position {n} of the batch
+        inline void set(int n, const tensor_type & tensor)
+        {
+            for (int k = 0; k < S; ++k) {
+                _data[k * N + n] = tensor[k];
+            }
+            return;
+        }
+
+      private:
+        // data (component major)
+        alignas(simd_bytes) std::array<T, S * N> _data;
+    };
+
+    // typedef for batches of vectors
+    template <int D, int N, typename T = real>
+    using VectorBatch = TensorBatch<D, 1, N, T>;
+
+    // typedef for batches of scalars
+    template <int N, typename T = real>
+    using ScalarBatch = TensorBatch<1, 1, N, T>;
+
+    // helper function: load component {k} of the pack of tensors starting at {n}
+    template <class P, int D1, int D2, int N, typename T>
+    inline P _load(const TensorBatch<D1, D2, N, T> & A, int k, int n)
+    {
+        return P::load(A.component(k) + n);
+    }
+
+    // helper function: store component {k} of the pack of tensors starting at {n}
+    template <class P, int D1, int D2, int N, typename T>
+    inline void _store(const P & value, TensorBatch<D1, D2, N, T> & A, int k, int n)
+    {
+        return value.store(A.component(k) + n);
+    }
+
+    // helper function: determinant of a pack of tensors
+    template <class P, int D, int N, typename T>
+    inline P _determinant(const TensorBatch<D, D, N, T> & A, int n)
+    {
+        static_assert(D == 2 || D == 3, "batched determinant only implemented for D = 2, 3");
+
+        if constexpr (D == 2) {
+            return _load<P>(A, 0, n) * _load<P>(A, 3, n) - _load<P>(A, 1, n) * _load<P>(A, 2, n);
+        } else {
+            P A0 = _load<P>(A, 0, n);
+            P A1 = _load<P>(A, 1, n);
+            P A2 = _load<P>(A, 2, n);
+            P A3 = _load<P>(A, 3, n);
+            P A4 = _load<P>(A, 4, n);
+            P A5 = _load<P>(A, 5, n);
+            P A6 = _load<P>(A, 6, n);
+            P A7 = _load<P>(A, 7, n);
+            P A8 = _load<P>(A, 8, n);
+            return A0 * (A4 * A8 - A5 * A7) - A1 * (A3 * A8 - A5 * A6)
+                 + A2 * (A3 * A7 - A4 * A6);
+        }
+    }
+
+    // batched determinant
+    template <int D, int N, typename T>
+    void ComputeDeterminant(const TensorBatch<D, D, N, T> & A, ScalarBatch<N, T> & det)
+    {
+        forEachPack<T>(
+            N, [&]<class P>(int n) { _store(_determinant<P>(A, n), det, 0 /* component */, n); });
+
+        // all done
+        return;
+    }
+
+    // batched inverse (returns the determinants in {det}; tensors with vanishing determinant are
+    // not detected, their inverse is not finite)
+    template <int D, int N, typename T>
+    void ComputeInverse(
+        const TensorBatch<D, D, N, T> & A, TensorBatch<D, D, N, T> & invA, ScalarBatch<N, T> & det)
+    {
+        static_assert(D == 2 || D == 3, "batched inverse only implemented for D = 2, 3");
+
+        forEachPack<T>(N, [&]<class P>(int n) {
+            P detA = _determinant<P>(A, n);
+            _store(detA, det, 0 /* component */, n);
+            P detinv = P(T(1)) / detA;
+
+            if constexpr (D == 2) {
+                P A0 = _load<P>(A, 0, n);
+                P A1 = _load<P>(A, 1, n);
+                P A2 = _load<P>(A, 2, n);
+                P A3 = _load<P>(A, 3, n);
+                _store(detinv * A3, invA, 0, n);
+                _store(-detinv * A1, invA, 1, n);
+                _store(-detinv * A2, invA, 2, n);
+                _store(detinv * A0, invA, 3, n);
+            } else {
+                P A0 = _load<P>(A, 0, n);
+                P A1 = _load<P>(A, 1, n);
+                P A2 = _load<P>(A, 2, n);
+                P A3 = _load<P>(A, 3, n);
+                P A4 = _load<P>(A, 4, n);
+                P A5 = _load<P>(A, 5, n);
+                P A6 = _load<P>(A, 6, n);
+                P A7 = _load<P>(A, 7, n);
+                P A8 = _load<P>(A, 8, n);
+                _store(detinv * (A4 * A8 - A5 * A7), invA, 0, n);
+                _store(detinv * (A2 * A7 - A1 * A8), invA, 1, n);
+                _store(detinv * (A1 * A5 - A2 * A4), invA, 2, n);
+                _store(detinv * (A5 * A6 - A3 * A8), invA, 3, n);
+                _store(detinv * (A0 * A8 - A2 * A6), invA, 4, n);
+                _store(detinv * (A2 * A3 - A0 * A5), invA, 5, n);
+                _store(detinv * (A3 * A7 - A4 * A6), invA, 6, n);
+                _store(detinv * (A1 * A6 - A0 * A7), invA, 7, n);
+                _store(detinv * (A0 * A4 - A1 * A3), invA, 8, n);
+            }
+        });
+
+        // all done
+        return;
+    }
+
+    // batched transpose (the components are stored as they are read, so {AT} must not be {A})
+    template <int D1, int D2, int N, typename T>
+    void ComputeTranspose(const TensorBatch<D1, D2, N, T> & A, TensorBatch<D2, D1, N, T> & AT)
+    {
+        // assert the output does not alias the input
+        assert(static_cast<const void *>(&A) != static_cast<const void *>(&AT));
+
+        forEachPack<T>(N, [&]<class P>(int n) {
+            for (int i = 0; i < D1; ++i) {
+                for (int j = 0; j < D2; ++j) {
+                    _store(_load<P>(A, i * D2 + j, n), AT, j * D1 + i, n);
+                }
+            }
+        });
+
+        // all done
+        return;
+    }
+
+    // batched product: matrix-matrix if D3 > 1, matrix-vector if D3 = 1 (VectorBatch) (the
+    // components are stored as they are computed, so {C} must be neither {A} nor {B})
+    template <int D1, int D2, int D3, int N, typename T>
+    void ComputeProduct(
+        const TensorBatch<D1, D2, N, T> & A, const TensorBatch<D2, D3, N, T> & B,
+        TensorBatch<D1, D3, N, T> & C)
+    {
+        // assert the output does not alias the inputs
+        assert(static_cast<const void *>(&C) != static_cast<const void *>(&A));
+        assert(static_cast<const void *>(&C) != static_cast<const void *>(&B));
+
+        forEachPack<T>(N, [&]<class P>(int n) {
+            for (int i = 0; i < D1; ++i) {
+                for (int j = 0; j < D3; ++j) {
+                    P Cij = _load<P>(A, i * D2, n) * _load<P>(B, j, n);
+                    for (int k = 1; k < D2; ++k) {
+                        Cij = Cij + _load<P>(A, i * D2 + k, n) * _load<P>(B, k * D3 + j, n);
+                    }
+                    _store(Cij, C, i * D3 + j, n);
+                }
+            }
+        });
+
+        // all done
+        return;
+    }
+
+    // batched trace
+    template <int D, int N, typename T>
+    void ComputeTrace(const TensorBatch<D, D, N, T> & A, ScalarBatch<N, T> & trace)
+    {
+        forEachPack<T>(N, [&]<class P>(int n) {
+            P trA = _load<P>(A, 0, n);
+            for (int i = 1; i < D; ++i) {
+                trA = trA + _load<P>(A, i * D + i, n);
+            }
+            _store(trA, trace, 0 /* component */, n);
+        });
+
+        // all done
+        return;
+    }
+
+}    // namespace mito
+
+#endif    // mito_algebra_TensorBatch_h
+
+// end of file
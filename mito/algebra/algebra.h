@@ -19,269 +19,200 @@ namespace mito {
 
     // helper function
     template <typename... Args>
-    bool all(Args... args)
+    constexpr bool all(Args... args)
     {
         return (args && ...);
     }
 
     // helper function
-    template <typename T, int... I, size_t... J>
-    bool operatorEqualEqual(
-        std::index_sequence<J...>, const SmallGrid<T, I...> & lhs, const SmallGrid<T, I...> & rhs)
+    template <class E1, class E2, size_t... J>
+    constexpr bool operatorEqualEqual(std::index_sequence<J...>, const E1 & lhs, const E2 & rhs)
     {
         if (all((lhs[J] == rhs[J])...))
             return true;
         return false;
     }
 
-    template <typename T, int... I>
-    inline bool operator==(const SmallGrid<T, I...> & lhs, const SmallGrid<T, I...> & rhs)
+    template <class E1, class E2>
+    constexpr bool operator==(const E1 & lhs, const E2 & rhs) requires(same_grid<E1, E2>)
     {
-        constexpr int D = SmallGrid<T, I...>::S;
+        constexpr int D = grid_of_t<E1>::S;
         // all done
         return operatorEqualEqual(std::make_index_sequence<D> {}, lhs, rhs);
     }
 
 
     // Algebraic operations on vectors, tensors, ...
-    // TOFIX: generalize with respect to scalar type (in this case real)
+    // The operators below take grids or expressions on grids and return expressions (see
+    // expressions.h), which are only evaluated when assigned to a grid
+    // The scalars are of the underlying type of the grids (e.g. {2.0 * x} with {x} a vector_t of
+    // floats scales by a float)
 
     // vector_t times scalar
-    template <typename T, int... I, size_t... J>
-    inline void _vector_times_scalar(
-        const real & a, const SmallGrid<T, I...> & y, SmallGrid<T, I...> & result,
-        std::index_sequence<J...>)
-    {
-        ((result[J] = y[J] * a), ...);
-        return;
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator*(const real & a, SmallGrid<T, I...> && y) requires(
-        SmallGrid<T, I...>::S != 1)
-    {
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_times_scalar(a, y, y, std::make_index_sequence<D> {});
-        return std::move(y);
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> operator*(const real & a, const SmallGrid<T, I...> & y) requires(
-        SmallGrid<T, I...>::S != 1)
-    {
-        SmallGrid<T, I...> result;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_times_scalar(a, y, result, std::make_index_sequence<D> {});
-        return result;
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator*(SmallGrid<T, I...> && y, const real & a) requires(
-        SmallGrid<T, I...>::S != 1)
+    template <class E>
+    constexpr auto operator*(const typename grid_of_t<E>::type & a, E && y) requires(
+        grid_expression<E> && grid_of_t<E>::S != 1)
     {
-        return a * std::move(y);
+        return ScaledExpression<operand_t<E>, typename grid_of_t<E>::type>(a, std::forward<E>(y));
     }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> operator*(const SmallGrid<T, I...> & y, const real & a) requires(
-        SmallGrid<T, I...>::S != 1)
+    template <class E>
+    constexpr auto operator*(E && y, const typename grid_of_t<E>::type & a) requires(
+        grid_expression<E> && grid_of_t<E>::S != 1)
     {
-        return a * y;
+        return a * std::forward<E>(y);
     }
 
     // vector_t inner product
-    template <typename T, int... I, std::size_t... J>
-    inline T _vector_inner_product(
-        const SmallGrid<T, I...> & y1, const SmallGrid<T, I...> & y2, std::index_sequence<J...>)
+    template <class E1, class E2, std::size_t... J>
+    constexpr auto _vector_inner_product(const E1 & y1, const E2 & y2, std::index_sequence<J...>)
     {
         return ((y1[J] * y2[J]) + ...);
     }
-    template <typename T, int... I>
-    inline T operator*(const SmallGrid<T, I...> & y1, const SmallGrid<T, I...> & y2)
+    template <class E1, class E2>
+    constexpr auto operator*(const E1 & y1, const E2 & y2) requires(
+        same_grid<E1, E2> && grid_of_t<E1>::N == 1)
     {
-        constexpr int D = SmallGrid<T, I...>::S;
+        constexpr int D = grid_of_t<E1>::S;
         return _vector_inner_product(y1, y2, std::make_index_sequence<D> {});
     }
-    template <typename T, int... I>
-    inline T operator*(SmallGrid<T, I...> && y1, const SmallGrid<T, I...> & y2)
-    {
-        constexpr int D = SmallGrid<T, I...>::S;
-        return _vector_inner_product(std::move(y1), y2, std::make_index_sequence<D> {});
-    }
-    template <typename T, int... I>
-    inline T operator*(const SmallGrid<T, I...> & y1, SmallGrid<T, I...> && y2)
+
+    // full contraction of grids of rank 2 or more (for tensors, the double contraction A:B)
+    template <class E1, class E2>
+    constexpr auto ddot(const E1 & A, const E2 & B) requires(
+        same_grid<E1, E2> && grid_of_t<E1>::N >= 2)
     {
-        constexpr int D = SmallGrid<T, I...>::S;
-        return _vector_inner_product(y1, std::move(y2), std::make_index_sequence<D> {});
+        constexpr int S = grid_of_t<E1>::S;
+        return _vector_inner_product(A, B, std::make_index_sequence<S> {});
     }
-    template <typename T, int... I>
-    inline T operator*(SmallGrid<T, I...> && y1, SmallGrid<T, I...> && y2)
+
+    // full contraction of grids of rank 2 or more (deprecated: A * B used to be the product of
+    // matrices)
+    template <class E1, class E2>
+    [[deprecated("A * B of grids of rank 2 or more is the full contraction: use ddot(A, B), or "
+                 "dot(A, B) for the matrix product")]] constexpr auto
+    operator*(const E1 & y1, const E2 & y2) requires(same_grid<E1, E2> && grid_of_t<E1>::N != 1)
     {
-        constexpr int D = SmallGrid<T, I...>::S;
-        return _vector_inner_product(std::move(y1), std::move(y2), std::make_index_sequence<D> {});
+        return ddot(y1, y2);
     }
 
     // sum of vector_ts
-    template <typename T, int... I, std::size_t... J>
-    inline void _vector_sum(
-        const SmallGrid<T, I...> & y1, const SmallGrid<T, I...> & y2, SmallGrid<T, I...> & result,
-        std::index_sequence<J...>)
+    template <class E1, class E2>
+    constexpr auto operator+(E1 && y1, E2 && y2) requires(same_grid<E1, E2>)
     {
-        ((result[J] = y1[J] + y2[J]), ...);
-        return;
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> operator+(
-        const SmallGrid<T, I...> & y1, const SmallGrid<T, I...> & y2)
-    {
-        // std::cout << "operator+ new temp" << std::endl;
-        SmallGrid<T, I...> result;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_sum(y1, y2, result, std::make_index_sequence<D> {});
-        return result;
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator+(SmallGrid<T, I...> && y1, const SmallGrid<T, I...> & y2)
-    {
-        // std::cout << "operator+ no temp && &" << std::endl;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_sum(y1, y2, y1, std::make_index_sequence<D> {});
-        return std::move(y1);
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator+(const SmallGrid<T, I...> & y1, SmallGrid<T, I...> && y2)
-    {
-        // std::cout << "operator+ no temp & &&" << std::endl;
-        return std::move(y2) + y1;
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator+(SmallGrid<T, I...> && y1, SmallGrid<T, I...> && y2)
-    {
-        // std::cout << "operator+ no temp && &&" << std::endl;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_sum(y1, y2, y1, std::make_index_sequence<D> {});
-        return std::move(y1);
+        return SumExpression<operand_t<E1>, operand_t<E2>>(
+            std::forward<E1>(y1), std::forward<E2>(y2));
     }
 
     // vector_t operator-
-    template <typename T, int... I, std::size_t... J>
-    inline void _vector_minus(
-        const SmallGrid<T, I...> & y, SmallGrid<T, I...> & result, std::index_sequence<J...>)
-    {
-        ((result[J] = -y[J]), ...);
-        return;
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> operator-(const SmallGrid<T, I...> & y)
+    template <class E>
+    constexpr auto operator-(E && y) requires(grid_expression<E>)
     {
-        // std::cout << "unary operator- new temp" << std::endl;
-        SmallGrid<T, I...> result;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_minus(y, result, std::make_index_sequence<D> {});
-        return result;
+        return OppositeExpression<operand_t<E>>(std::forward<E>(y));
     }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator-(SmallGrid<T, I...> && y)
+    template <class E1, class E2>
+    constexpr auto operator-(E1 && y1, E2 && y2) requires(same_grid<E1, E2>)
     {
-        // std::cout << "unary operator- no temp &&" << std::endl;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_minus(y, y, std::make_index_sequence<D> {});
-        return std::move(y);
-    }
-    template <typename T, int... I, std::size_t... J>
-    inline void _vector_minus(
-        const SmallGrid<T, I...> & y1, const SmallGrid<T, I...> & y2, SmallGrid<T, I...> & result,
-        std::index_sequence<J...>)
-    {
-        ((result[J] = y1[J] - y2[J]), ...);
-        return;
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> operator-(
-        const SmallGrid<T, I...> & y1, const SmallGrid<T, I...> & y2)
-    {
-        // std::cout << "binary operator- new temp" << std::endl;
-        SmallGrid<T, I...> result;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_minus(y1, y2, result, std::make_index_sequence<D> {});
-        return result;
-        // return y1 + (-y2);
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator-(SmallGrid<T, I...> && y1, const SmallGrid<T, I...> & y2)
-    {
-        // std::cout << "binary operator- no temp && &" << std::endl;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_minus(y1, y2, y1, std::make_index_sequence<D> {});
-        return std::move(y1);
-        // return std::move(y1) + (-y2);
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator-(const SmallGrid<T, I...> & y1, SmallGrid<T, I...> && y2)
-    {
-        // std::cout << "binary operator- no temp & &&" << std::endl;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_minus(y1, y2, y2, std::make_index_sequence<D> {});
-        return std::move(y2);
-        // return y1 + (-std::move(y2));
-    }
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator-(SmallGrid<T, I...> && y1, SmallGrid<T, I...> && y2)
-    {
-        // std::cout << "binary operator- no temp && &&" << std::endl;
-        constexpr int D = SmallGrid<T, I...>::S;
-        _vector_minus(y1, y2, y1, std::make_index_sequence<D> {});
-        return std::move(y1);
-        // return std::move(y1) + (-std::move(y2));
-    }
-
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> operator/(const SmallGrid<T, I...> & y, const real & a) requires(
-        SmallGrid<T, I...>::S != 1)
-    {
-        return (1.0 / a) * y;
+        return DifferenceExpression<operand_t<E1>, operand_t<E2>>(
+            std::forward<E1>(y1), std::forward<E2>(y2));
     }
 
-    template <typename T, int... I>
-    inline SmallGrid<T, I...> && operator/(SmallGrid<T, I...> && y, const real & a) requires(
-        SmallGrid<T, I...>::S != 1)
+    template <class E>
+    constexpr auto operator/(E && y, const typename grid_of_t<E>::type & a) requires(
+        grid_expression<E> && grid_of_t<E>::S != 1)
     {
-        return (1.0 / a) * std::move(y);
+        using T = typename grid_of_t<E>::type;
+        return (T(1) / a) * std::forward<E>(y);
     }
 
     // matrix-vector multiplication
-    // row-vector product
-    template <int D1, int D2, typename T, size_t... J>
-    inline T _row_times_vector(
-        const tensor_t<D1, D2, T> & A, const vector_t<D2, T> & x, size_t row,
-        std::index_sequence<J...>)
-    {
-        return ((A[row * D2 + J] /*A[{ row, J }]*/ * x[J]) + ...);
-    }
-    // matrix-vector product
-    template <int D1, int D2, typename T, size_t... J>
-    inline vector_t<D1, T> _matrix_times_vector(
-        const tensor_t<D1, D2, T> & A, const vector_t<D2, T> & x, std::index_sequence<J...>)
-    {
-        vector_t<D1, T> result;
-        ((result[J] = _row_times_vector(A, x, J, std::make_index_sequence<D2> {})), ...);
-        return result;
-    }
-    template <int D1, int D2, typename T>
-    inline vector_t<D1, T> operator*(const tensor_t<D1, D2, T> & A, const vector_t<D2, T> & x)
-    {
-        return _matrix_times_vector(A, x, std::make_index_sequence<D1> {});
+    template <class EA, class EX>
+    constexpr auto operator*(EA && A, EX && x) requires(
+        grid_expression<EA> && grid_expression<EX> && grid_of_t<EA>::N == 2
+        && grid_of_t<EX>::N == 1 && grid_of_t<EA>::shape[1] == grid_of_t<EX>::S
+        && std::is_same_v<typename grid_of_t<EA>::type, typename grid_of_t<EX>::type>)
+    {
+        // the number of rows of the matrix
+        constexpr int D1 = grid_of_t<EA>::shape[0];
+        // the type of the resulting vector
+        using result_t = vector_t<D1, typename grid_of_t<EX>::type>;
+        return MatrixVectorExpression<operand_t<EA>, evaluated_operand_t<EX>, result_t>(
+            std::forward<EA>(A), std::forward<EX>(x));
+    }
+
+    // matrix-matrix multiplication (the single contraction A.B)
+    template <class EA, class EB>
+    constexpr auto dot(EA && A, EB && B) requires(
+        grid_expression<EA> && grid_expression<EB> && grid_of_t<EA>::N == 2
+        && grid_of_t<EB>::N == 2 && grid_of_t<EA>::shape[1] == grid_of_t<EB>::shape[0]
+        && std::is_same_v<typename grid_of_t<EA>::type, typename grid_of_t<EB>::type>)
+    {
+        // the number of rows of the first matrix
+        constexpr int D1 = grid_of_t<EA>::shape[0];
+        // the number of columns of the second matrix
+        constexpr int D3 = grid_of_t<EB>::shape[1];
+        // the type of the resulting matrix
+        using result_t = tensor_t<D1, D3, typename grid_of_t<EA>::type>;
+        return MatrixMatrixExpression<
+            evaluated_operand_t<EA>, evaluated_operand_t<EB>, result_t>(
+            std::forward<EA>(A), std::forward<EB>(B));
+    }
+
+    // transpose (a view on the entries of the matrix, so that e.g. {dot(transpose(A), B)} reads A
+    // in place)
+    template <class E>
+    constexpr auto transpose(E && A) requires(grid_expression<E> && grid_of_t<E>::N == 2)
+    {
+        // the type of the transposed matrix
+        using result_t = tensor_t<
+            grid_of_t<E>::shape[1], grid_of_t<E>::shape[0], typename grid_of_t<E>::type>;
+        return TransposeExpression<operand_t<E>, result_t>(std::forward<E>(A));
+    }
+
+    // dyadic (outer) product of vector_ts
+    template <class EX, class EY>
+    constexpr auto dyadic(EX && x, EY && y) requires(
+        grid_expression<EX> && grid_expression<EY> && grid_of_t<EX>::N == 1
+        && grid_of_t<EY>::N == 1
+        && std::is_same_v<typename grid_of_t<EX>::type, typename grid_of_t<EY>::type>)
+    {
+        // the type of the resulting matrix
+        using result_t =
+            tensor_t<grid_of_t<EX>::S, grid_of_t<EY>::S, typename grid_of_t<EX>::type>;
+        return DyadicExpression<evaluated_operand_t<EX>, evaluated_operand_t<EY>, result_t>(
+            std::forward<EX>(x), std::forward<EY>(y));
+    }
+
+    // trace of a tensor
+    template <class E, std::size_t... I>
+    constexpr auto _tensor_trace(const E & A, std::index_sequence<I...>)
+    {
+        constexpr int D = grid_of_t<E>::shape[0];
+        return (A[I * D + I] + ...);
+    }
+    template <class E>
+    constexpr auto ComputeTrace(const E & A) requires(
+        grid_expression<E> && grid_of_t<E>::N == 2
+        && grid_of_t<E>::shape[0] == grid_of_t<E>::shape[1])
+    {
+        constexpr int D = grid_of_t<E>::shape[0];
+        return _tensor_trace(A, std::make_index_sequence<D> {});
     }
 
     // factorial
     template <int D>
-    int Factorial()
+    constexpr int Factorial()
     {
         return D * Factorial<int(D - 1)>();
     }
     template <>
-    int Factorial<1>()
+    constexpr int Factorial<1>()
     {
         return 1;
     }
 
-    real ComputeDeterminant(const tensor_t<4> & A)
+    // closed forms of the determinant and of the inverse of small tensors (fast paths, the generic
+    // templates below are used for other dimensions)
+    constexpr real ComputeDeterminant(const tensor_t<4> & A)
     {
         return A[1] * A[11] * A[14] * A[4] - A[1] * A[10] * A[15] * A[4]
              - A[11] * A[13] * A[2] * A[4] + A[10] * A[13] * A[3] * A[4]
@@ -295,15 +226,15 @@ namespace mito {
              + A[12] * A[3] * A[6] * A[9] + A[0] * A[14] * A[7] * A[9] - A[12] * A[2] * A[7] * A[9];
     }
 
-    real ComputeDeterminant(const tensor_t<3> & A)
+    constexpr real ComputeDeterminant(const tensor_t<3> & A)
     {
         return A[0] * (A[4] * A[8] - A[5] * A[7]) - A[1] * (A[3] * A[8] - A[5] * A[6])
              + A[2] * (A[3] * A[7] - A[4] * A[6]);
     }
 
-    real ComputeDeterminant(const tensor_t<2> & A) { return A[0] * A[3] - A[1] * A[2]; }
+    constexpr real ComputeDeterminant(const tensor_t<2> & A) { return A[0] * A[3] - A[1] * A[2]; }
 
-    real ComputeInverse(const tensor_t<3> & A, tensor_t<3> & invA)
+    constexpr real ComputeInverse(const tensor_t<3> & A, tensor_t<3> & invA)
     {
         real det = ComputeDeterminant(A);
         assert(det != 0.0);
@@ -322,7 +253,7 @@ namespace mito {
         return det;
     }
 
-    real ComputeInverse(const tensor_t<2> & A, tensor_t<2> & invA)
+    constexpr real ComputeInverse(const tensor_t<2> & A, tensor_t<2> & invA)
     {
         real det = ComputeDeterminant(A);
         assert(det != 0.0);
@@ -335,24 +266,238 @@ namespace mito {
 
         return det;
     }
+
+    // Generic LU factorization, determinant, inverse and linear solve for square tensors of any
+    // (small) dimension D. The loops on rows and columns are unrolled at compile time with index
+    // sequences, only the search for the pivot is a loop.
+
+    // typedef for row permutations (the dimension is deduced from the tensors, not from these)
+    template <int D>
+    using permutation_t = std::type_identity_t<std::array<int, D>>;
+
+    // helper function: absolute value (usable in constant expressions)
+    template <typename T>
+    constexpr T _abs(const T & a)
+    {
+        return a < T(0) ? -a : a;
+    }
+
+    // helper function: eliminate entry (i, K) of the LU factorization, with J over columns > K
+    template <int K, int D, typename T, size_t... J>
+    constexpr void _lu_eliminate_row(tensor_t<D, D, T> & LU, int i, std::index_sequence<J...>)
+    {
+        // the multiplier (entry (i, K) of L)
+        const T l = (LU[i * D + K] /= LU[K * D + K]);
+        // update the remaining entries of row i
+        ((LU[i * D + (K + 1 + J)] -= l * LU[K * D + (K + 1 + J)]), ...);
+        return;
+    }
+
+    // helper function: eliminate column K below the diagonal, with I over the rows > K
+    template <int K, int D, typename T, size_t... I>
+    constexpr void _lu_eliminate(tensor_t<D, D, T> & LU, std::index_sequence<I...>)
+    {
+        ((_lu_eliminate_row<K>(LU, K + 1 + I, std::make_index_sequence<D - K - 1> {})), ...);
+        return;
+    }
+
+    // helper function: swap rows {i} and {j}, with J over the columns
+    template <int D, typename T, size_t... J>
+    constexpr void _swap_rows(tensor_t<D, D, T> & A, int i, int j, std::index_sequence<J...>)
+    {
+        ((std::swap(A[i * D + J], A[j * D + J])), ...);
+        return;
+    }
+
+    // helper function: step K of the LU factorization with partial pivoting (returns false if the
+    // tensor is singular)
+    template <int K, int D, typename T>
+    constexpr bool _lu_step(tensor_t<D, D, T> & LU, permutation_t<D> & permutation, int & sign)
+    {
+        if constexpr (K == D) {
+            return true;
+        } else {
+            // find the pivot: the largest entry in column K on or below the diagonal
+            int pivot = K;
+            for (int i = K + 1; i < D; ++i) {
+                if (_abs(LU[i * D + K]) > _abs(LU[pivot * D + K])) {
+                    pivot = i;
+                }
+            }
+
+            // the tensor is singular
+            if (LU[pivot * D + K] == T(0)) {
+                return false;
+            }
+
+            // move the pivot on the diagonal
+            if (pivot != K) {
+                _swap_rows(LU, K, pivot, std::make_index_sequence<D> {});
+                std::swap(permutation[K], permutation[pivot]);
+                sign = -sign;
+            }
+
+            // eliminate the entries below the pivot and move on to the next column
+            _lu_eliminate<K>(LU, std::make_index_sequence<D - K - 1> {});
+            return _lu_step<K + 1>(LU, permutation, sign);
+        }
+    }
+
+    // helper function: product of the diagonal entries
+    template <int D, typename T, size_t... I>
+    constexpr T _diagonal_product(const tensor_t<D, D, T> & A, std::index_sequence<I...>)
+    {
+        return (A[I * D + I] * ...);
+    }
+
+    /**
+     * @brief Computes the LU factorization with partial pivoting PA = LU of a square tensor
+     *
+     * @param A the tensor to factorize
+     * @param LU the factors: L (unit lower triangular, diagonal not stored) and U, packed together
+     * @param permutation the row permutation P: row i of PA is row permutation[i] of A
+     * @return the determinant of A (zero if A is singular, in which case LU is incomplete)
+     */
+    template <int D, typename T>
+    constexpr T ComputeLU(
+        const tensor_t<D, D, T> & A, tensor_t<D, D, T> & LU, permutation_t<D> & permutation)
+    {
+        // initialize the factors and the permutation
+        LU = A;
+        for (int i = 0; i < D; ++i) {
+            permutation[i] = i;
+        }
+
+        // factorize
+        int sign = 1;
+        if (!_lu_step<0>(LU, permutation, sign)) {
+            return T(0);
+        }
+
+        // all done
+        return sign * _diagonal_product(LU, std::make_index_sequence<D> {});
+    }
+
+    // helper function: forward substitution for row I of L y = P b, with J over the columns < I
+    template <int I, int D, typename T, size_t... J>
+    constexpr T _forward_row(
+        const tensor_t<D, D, T> & LU, const vector_t<D, T> & y, const T & b,
+        std::index_sequence<J...>)
+    {
+        return (b - ... - (LU[I * D + J] * y[J]));
+    }
+
+    // helper function: backward substitution for row I of U x = y, with J over the columns > I
+    template <int I, int D, typename T, size_t... J>
+    constexpr T _backward_row(
+        const tensor_t<D, D, T> & LU, const vector_t<D, T> & x, const T & y,
+        std::index_sequence<J...>)
+    {
+        return (y - ... - (LU[I * D + (I + 1 + J)] * x[I + 1 + J])) / LU[I * D + I];
+    }
+
+    // helper function: forward and backward substitution, with I over the rows
+    template <int D, typename T, size_t... I>
+    constexpr vector_t<D, T> _substitute(
+        const tensor_t<D, D, T> & LU, const permutation_t<D> & permutation,
+        const vector_t<D, T> & b, std::index_sequence<I...>)
+    {
+        // forward substitution (rows in increasing order)
+        vector_t<D, T> y;
+        ((y[I] = _forward_row<I>(LU, y, b[permutation[I]], std::make_index_sequence<I> {})), ...);
+        // backward substitution (rows in decreasing order)
+        vector_t<D, T> x;
+        ((x[D - 1 - I] = _backward_row<D - 1 - I>(
+              LU, x, y[D - 1 - I], std::make_index_sequence<I> {})),
+         ...);
+        // all done
+        return x;
+    }
+
+    // solve the linear system A x = b given the LU factorization of A (see ComputeLU)
+    template <int D, typename T>
+    constexpr vector_t<D, T> SolveLU(
+        const tensor_t<D, D, T> & LU, const permutation_t<D> & permutation,
+        const vector_t<D, T> & b)
+    {
+        return _substitute(LU, permutation, b, std::make_index_sequence<D> {});
+    }
+
+    // solve the linear system A x = b
+    template <int D, typename T>
+    constexpr vector_t<D, T> Solve(const tensor_t<D, D, T> & A, const vector_t<D, T> & b)
+    {
+        tensor_t<D, D, T> LU;
+        permutation_t<D> permutation;
+        [[maybe_unused]] T det = ComputeLU(A, LU, permutation);
+        assert(det != T(0));
+        return SolveLU(LU, permutation, b);
+    }
+
+    // determinant of a square tensor of any dimension
+    template <int D, typename T>
+    constexpr T ComputeDeterminant(const tensor_t<D, D, T> & A)
+    {
+        tensor_t<D, D, T> LU;
+        permutation_t<D> permutation;
+        return ComputeLU(A, LU, permutation);
+    }
+
+    // helper function: solve for column J of the inverse, with I over the rows
+    template <int J, int D, typename T, size_t... I>
+    constexpr void _inverse_column(
+        const tensor_t<D, D, T> & LU, const permutation_t<D> & permutation,
+        tensor_t<D, D, T> & invA, std::index_sequence<I...>)
+    {
+        // the J-th column of the identity
+        constexpr vector_t<D, T> e { T(int(I) == J)... };
+        // the J-th column of the inverse
+        const vector_t<D, T> column = SolveLU(LU, permutation, e);
+        ((invA[I * D + J] = column[I]), ...);
+        return;
+    }
+
+    // helper function: solve for all columns J of the inverse
+    template <int D, typename T, size_t... J>
+    constexpr void _inverse(
+        const tensor_t<D, D, T> & LU, const permutation_t<D> & permutation,
+        tensor_t<D, D, T> & invA, std::index_sequence<J...>)
+    {
+        ((_inverse_column<J>(LU, permutation, invA, std::make_index_sequence<D> {})), ...);
+        return;
+    }
+
+    // inverse of a square tensor of any dimension (returns the determinant)
+    template <int D, typename T>
+    constexpr T ComputeInverse(const tensor_t<D, D, T> & A, tensor_t<D, D, T> & invA)
+    {
+        tensor_t<D, D, T> LU;
+        permutation_t<D> permutation;
+        T det = ComputeLU(A, LU, permutation);
+        assert(det != T(0));
+
+        _inverse(LU, permutation, invA, std::make_index_sequence<D> {});
+
+        return det;
+    }
 }
 
 // overload operator<< for vectors and tensors
-std::ostream &
+inline std::ostream &
 operator<<(std::ostream & os, const mito::vector_t<3> & x)
 {
     os << "(" << x[0] << ", " << x[1] << ", " << x[2] << ")";
     return os;
 }
 
-std::ostream &
+inline std::ostream &
 operator<<(std::ostream & os, const mito::vector_t<2> & x)
 {
     os << "(" << x[0] << ", " << x[1] << ")";
     return os;
 }
 
-std::ostream &
+inline std::ostream &
 operator<<(std::ostream & os, const mito::tensor_t<3> & x)
 {
     os << "(" << x[0] << ", " << x[1] << ", " << x[2] << "; " << x[3] << ", " << x[4] << ", "
@@ -360,7 +505,7 @@ operator<<(std::ostream & os, const mito::tensor_t<3> & x)
     return os;
 }
 
-std::ostream &
+inline std::ostream &
 operator<<(std::ostream & os, const mito::tensor_t<2> & x)
 {
     os << "(" << x[0] << ", " << x[1] << "; " << x[2] << ", " << x[3] << ")";
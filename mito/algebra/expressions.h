@@ -0,0 +1,268 @@
+// code guard
+#if !defined(mito_algebra_expressions_h)
+#define mito_algebra_expressions_h
+
+#include <type_traits>
+#include <utility>
+
+// Lazy expressions on grids: the algebraic operators on SmallGrid return lightweight expression
+// objects instead of grids, so that an expression like {a * x + b * y - z} is evaluated in a single
+// pass, component by component, only when it is assigned to a SmallGrid.
+//
+// NOTE: as with any expression template, do not hold an expression with {auto} beyond the lifetime
+//       of the grids it references (operands that are temporaries are stored by value, so
+//       expressions returned from functions are safe as long as they do not reference locals).
+
+namespace mito {
+
+    // the grid type an object (a grid or an expression on grids) evaluates to
+    template <class E>
+    using grid_of_t = typename std::remove_cvref_t<E>::grid_type;
+
+    // a grid or an expression on grids
+    template <class E>
+    concept grid_expression = requires { typename grid_of_t<E>; };
+
+    // an expression (not a grid itself) that evaluates to a grid of type {G}
+    template <class E, class G>
+    concept expression_of = grid_expression<E> && std::is_same_v<grid_of_t<E>, G>
+                         && !std::is_same_v<std::remove_cvref_t<E>, G>;
+
+    // two grids or expressions evaluating to the same type of grid
+    template <class E1, class E2>
+    concept same_grid =
+        grid_expression<E1> && grid_expression<E2> && std::is_same_v<grid_of_t<E1>, grid_of_t<E2>>;
+
+    // how an expression stores its operands: lvalues are stored by reference, rvalues (i.e.
+    // temporaries, typically other expressions) are stored by value
+    template <class E>
+    using operand_t = std::conditional_t<
+        std::is_lvalue_reference_v<E>, const std::remove_reference_t<E> &, std::remove_cvref_t<E>>;
+
+    // whether reading an entry of {E} is as cheap as reading an entry of a grid: grids and views
+    // (expressions that only rearrange the entries of a grid, e.g. a transpose)
+    template <class E>
+    constexpr bool is_view()
+    {
+        if constexpr (std::is_same_v<std::remove_cvref_t<E>, grid_of_t<E>>) {
+            return true;
+        } else if constexpr (requires { std::remove_cvref_t<E>::view; }) {
+            return std::remove_cvref_t<E>::view;
+        } else {
+            return false;
+        }
+    }
+
+    // how an expression stores an operand whose entries are read more than once: grids and views
+    // are stored as any other operand, expressions are evaluated once into a grid stored by value
+    template <class E>
+    using evaluated_operand_t = std::conditional_t<is_view<E>(), operand_t<E>, grid_of_t<E>>;
+
+    // base class of the expressions (CRTP) evaluating to a grid of type {G}
+    template <class E, class G>
+    class GridExpression {
+
+      public:
+        // the type of the grid the expression evaluates to
+        using grid_type = G;
+        // the underlying type
+        using type = typename G::type;
+        // the number of indices
+        static constexpr int N = G::N;
+        // the number of cells
+        static constexpr int S = G::S;
+
+      public:
+        // evaluate the expression into a grid
+        constexpr G evaluate() const { return G(static_cast<const E &>(*this)); }
+
+        // enable cast to underlying type if S = 1 (scalar expression)
+        constexpr operator type() const requires(S == 1)
+        {
+            return static_cast<const E &>(*this)[0];
+        }
+    };
+
+    // y1 + y2
+    template <class E1, class E2>
+    class SumExpression : public GridExpression<SumExpression<E1, E2>, grid_of_t<E1>> {
+      public:
+        template <class F1, class F2>
+        constexpr SumExpression(F1 && y1, F2 && y2) :
+            _y1(std::forward<F1>(y1)),
+            _y2(std::forward<F2>(y2))
+        {}
+
+        constexpr auto operator[](int i) const { return _y1[i] + _y2[i]; }
+
+      private:
+        E1 _y1;
+        E2 _y2;
+    };
+
+    // y1 - y2
+    template <class E1, class E2>
+    class DifferenceExpression :
+        public GridExpression<DifferenceExpression<E1, E2>, grid_of_t<E1>> {
+      public:
+        template <class F1, class F2>
+        constexpr DifferenceExpression(F1 && y1, F2 && y2) :
+            _y1(std::forward<F1>(y1)),
+            _y2(std::forward<F2>(y2))
+        {}
+
+        constexpr auto operator[](int i) const { return _y1[i] - _y2[i]; }
+
+      private:
+        E1 _y1;
+        E2 _y2;
+    };
+
+    // -y
+    template <class E>
+    class OppositeExpression : public GridExpression<OppositeExpression<E>, grid_of_t<E>> {
+      public:
+        template <class F>
+        constexpr OppositeExpression(F && y) : _y(std::forward<F>(y))
+        {}
+
+        constexpr auto operator[](int i) const { return -_y[i]; }
+
+      private:
+        E _y;
+    };
+
+    // a * y
+    template <class E, class A>
+    class ScaledExpression : public GridExpression<ScaledExpression<E, A>, grid_of_t<E>> {
+      public:
+        template <class F>
+        constexpr ScaledExpression(const A & a, F && y) : _a(a), _y(std::forward<F>(y))
+        {}
+
+        constexpr auto operator[](int i) const { return _y[i] * _a; }
+
+      private:
+        A _a;
+        E _y;
+    };
+
+    // A * x, with {G} the type of the resulting vector
+    template <class EA, class EX, class G>
+    class MatrixVectorExpression : public GridExpression<MatrixVectorExpression<EA, EX, G>, G> {
+
+        // the number of columns of the matrix
+        static constexpr int D2 = grid_of_t<EX>::S;
+
+      public:
+        template <class FA, class FX>
+        constexpr MatrixVectorExpression(FA && A, FX && x) :
+            _A(std::forward<FA>(A)),
+            _x(std::forward<FX>(x))
+        {}
+
+        // row-vector product
+        constexpr auto operator[](int i) const
+        {
+            return _row_times_vector(i, std::make_index_sequence<D2> {});
+        }
+
+      private:
+        template <size_t... J>
+        constexpr auto _row_times_vector(int row, std::index_sequence<J...>) const
+        {
+            return ((_A[row * D2 + J] * _x[J]) + ...);
+        }
+
+      private:
+        EA _A;
+        // the vector is read once per row, so it is evaluated only once
+        EX _x;
+    };
+
+    // dot(A, B), with {G} the type of the resulting matrix
+    template <class EA, class EB, class G>
+    class MatrixMatrixExpression : public GridExpression<MatrixMatrixExpression<EA, EB, G>, G> {
+
+        // the number of columns of the first matrix (rows of the second one)
+        static constexpr int D2 = grid_of_t<EA>::shape[1];
+        // the number of columns of the result
+        static constexpr int D3 = G::shape[1];
+
+      public:
+        template <class FA, class FB>
+        constexpr MatrixMatrixExpression(FA && A, FB && B) :
+            _A(std::forward<FA>(A)),
+            _B(std::forward<FB>(B))
+        {}
+
+        // row-column product
+        constexpr auto operator[](int k) const
+        {
+            return _row_times_column(k / D3, k % D3, std::make_index_sequence<D2> {});
+        }
+
+      private:
+        template <size_t... J>
+        constexpr auto _row_times_column(int row, int column, std::index_sequence<J...>) const
+        {
+            return ((_A[row * D2 + J] * _B[J * D3 + column]) + ...);
+        }
+
+      private:
+        // both matrices are read once per entry of the result, so they are evaluated only once
+        EA _A;
+        EB _B;
+    };
+
+    // A^T, with {G} the type of the transposed matrix
+    template <class E, class G>
+    class TransposeExpression : public GridExpression<TransposeExpression<E, G>, G> {
+
+        // the number of rows of the transpose (columns of the matrix)
+        static constexpr int D1 = G::shape[0];
+        // the number of columns of the transpose (rows of the matrix)
+        static constexpr int D2 = G::shape[1];
+
+      public:
+        // the transpose of a view only rearranges its entries
+        static constexpr bool view = is_view<E>();
+
+      public:
+        template <class F>
+        constexpr TransposeExpression(F && A) : _A(std::forward<F>(A))
+        {}
+
+        constexpr auto operator[](int k) const { return _A[(k % D2) * D1 + k / D2]; }
+
+      private:
+        E _A;
+    };
+
+    // x (x) y, with {G} the type of the resulting matrix
+    template <class EX, class EY, class G>
+    class DyadicExpression : public GridExpression<DyadicExpression<EX, EY, G>, G> {
+
+        // the number of columns of the result
+        static constexpr int D2 = G::shape[1];
+
+      public:
+        template <class FX, class FY>
+        constexpr DyadicExpression(FX && x, FY && y) :
+            _x(std::forward<FX>(x)),
+            _y(std::forward<FY>(y))
+        {}
+
+        constexpr auto operator[](int k) const { return _x[k / D2] * _y[k % D2]; }
+
+      private:
+        // both vectors are read once per entry of the result, so they are evaluated only once
+        EX _x;
+        EY _y;
+    };
+
+}    // namespace mito
+
+#endif    // mito_algebra_expressions_h
+
+// end of file
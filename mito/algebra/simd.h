@@ -0,0 +1,175 @@
+// code guard
+#if !defined(mito_algebra_simd_h)
+#define mito_algebra_simd_h
+
+#include <array>
+#include <cstring>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Packs of W values processed by one SIMD instruction. The pack width of a type is the width of the
+// widest vector instruction set the code is compiled for (AVX-512, AVX2), or a portable fallback
+// the compiler lowers to whatever target it has (SSE2, NEON, ...).
+
+namespace mito {
+
+    // the number of bytes processed by one SIMD instruction
+#if defined(__AVX512F__)
+    static constexpr int simd_bytes = 64;
+#elif defined(__AVX2__)
+    static constexpr int simd_bytes = 32;
+#else
+    static constexpr int simd_bytes = 16;
+#endif
+
+    // the number of values of type T in a SIMD pack
+    template <typename T>
+    static constexpr int simd_width = simd_bytes / sizeof(T) > 0 ? simd_bytes / sizeof(T) : 1;
+
+    // portable pack of W values of type T
+    template <typename T, int W = simd_width<T>>
+    class SimdPack {
+      public:
+        static constexpr int width = W;
+
+      private:
+#if defined(__GNUC__)
+        // generic vector of the GNU compilers (gcc, clang), lowered to the target instruction set
+        typedef T register_t __attribute__((vector_size(W * sizeof(T))));
+#else
+        using register_t = std::array<T, W>;
+#endif
+
+      public:
+        inline SimdPack() = default;
+        // broadcast {a} to all the entries of the pack
+        inline SimdPack(T a)
+        {
+            for (int i = 0; i < W; ++i) {
+                _data[i] = a;
+            }
+        }
+
+        // load W contiguous values (no alignment required)
+        static inline SimdPack load(const T * ptr)
+        {
+            SimdPack result;
+            std::memcpy(&result._data, ptr, sizeof(register_t));
+            return result;
+        }
+
+        // store W contiguous values (no alignment required)
+        inline void store(T * ptr) const { std::memcpy(ptr, &_data, sizeof(register_t)); }
+
+#if defined(__GNUC__)
+#define mito_simd_operator(op)                                                                     \
+    friend inline SimdPack operator op(const SimdPack & a, const SimdPack & b)                     \
+    {                                                                                              \
+        SimdPack result;                                                                           \
+        result._data = a._data op b._data;                                                         \
+        return result;                                                                             \
+    }
+#else
+#define mito_simd_operator(op)                                                                     \
+    friend inline SimdPack operator op(const SimdPack & a, const SimdPack & b)                     \
+    {                                                                                              \
+        SimdPack result;                                                                           \
+        for (int i = 0; i < W; ++i) {                                                              \
+            result._data[i] = a._data[i] op b._data[i];                                            \
+        }                                                                                          \
+        return result;                                                                             \
+    }
+#endif
+        mito_simd_operator(+)
+        mito_simd_operator(-)
+        mito_simd_operator(*)
+        mito_simd_operator(/)
+#undef mito_simd_operator
+
+        friend inline SimdPack operator-(const SimdPack & a) { return SimdPack(T(0)) - a; }
+
+      private:
+        register_t _data;
+    };
+
+    // specialization of a pack for a native SIMD register
+#define mito_simd_pack(T, W, register_t, suffix, bits)                                              \
+    template <>                                                                                    \
+    class SimdPack<T, W> {                                                                         \
+      public:                                                                                      \
+        static constexpr int width = W;                                                            \
+                                                                                                   \
+      public:                                                                                      \
+        inline SimdPack() = default;                                                               \
+        inline SimdPack(T a) : _data(_mm##bits##_set1_##suffix(a)) {}                              \
+        inline SimdPack(register_t data) : _data(data) {}                                          \
+                                                                                                   \
+        static inline SimdPack load(const T * ptr) { return _mm##bits##_loadu_##suffix(ptr); }     \
+        inline void store(T * ptr) const { _mm##bits##_storeu_##suffix(ptr, _data); }             \
+                                                                                                   \
+        friend inline SimdPack operator+(const SimdPack & a, const SimdPack & b)                   \
+        {                                                                                          \
+            return _mm##bits##_add_##suffix(a._data, b._data);                                     \
+        }                                                                                          \
+        friend inline SimdPack operator-(const SimdPack & a, const SimdPack & b)                   \
+        {                                                                                          \
+            return _mm##bits##_sub_##suffix(a._data, b._data);                                     \
+        }                                                                                          \
+        friend inline SimdPack operator*(const SimdPack & a, const SimdPack & b)                   \
+        {                                                                                          \
+            return _mm##bits##_mul_##suffix(a._data, b._data);                                     \
+        }                                                                                          \
+        friend inline SimdPack operator/(const SimdPack & a, const SimdPack & b)                   \
+        {                                                                                          \
+            return _mm##bits##_div_##suffix(a._data, b._data);                                     \
+        }                                                                                          \
+        friend inline SimdPack operator-(const SimdPack & a) { return SimdPack(T(0)) - a; }        \
+                                                                                                   \
+      private:                                                                                     \
+        register_t _data;                                                                          \
+    }
+
+#if defined(__AVX512F__)
+    mito_simd_pack(double, 8, __m512d, pd, 512);
+    mito_simd_pack(float, 16, __m512, ps, 512);
+#endif
+#if defined(__AVX2__)
+    mito_simd_pack(double, 4, __m256d, pd, 256);
+    mito_simd_pack(float, 8, __m256, ps, 256);
+#endif
+#undef mito_simd_pack
+
+    /**
+     * @brief Applies {kernel} to the values [0, n) of a structure of arrays, one pack at a time:
+     *          full SIMD packs first, then the remainder one value at a time
+     *
+     * @param n the number of values
+     * @param kernel a generic lambda invoked as kernel.template operator()<pack_t>(offset)
+     */
+    template <typename T, class F>
+    inline void forEachPack(int n, F && kernel)
+    {
+        // the native pack
+        using pack_t = SimdPack<T>;
+
+        // full packs
+        int i = 0;
+        for (; i + pack_t::width <= n; i += pack_t::width) {
+            kernel.template operator()<pack_t>(i);
+        }
+
+        // the remainder
+        for (; i < n; ++i) {
+            kernel.template operator()<SimdPack<T, 1>>(i);
+        }
+
+        // all done
+        return;
+    }
+
+}    // namespace mito
+
+#endif    // mito_algebra_simd_h
+
+// end of file
@@ -0,0 +1,56 @@
+#include <cmath>
+#include "../benchmark.h"
+#include "../structured_mesh.h"
+#include "../../math/Field.h"
+#include "../../mesh/ElementSet.h"
+#include "../../quadrature/Integrator.h"
+
+using mito::vector_t;
+using mito::tensor_t;
+using mito::real;
+using mito::GAUSS;
+
+// counts the heap allocations done by the algebra temporaries and by the integration of a field:
+// with the grids stored inline, both are expected to allocate nothing per element
+
+int
+main()
+{
+    // algebra temporaries
+    vector_t<3> x = { 1.0, 2.0, 3.0 };
+    vector_t<3> y = { 3.0, 2.0, 1.0 };
+    tensor_t<3> A = { 1.0, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 3.0 };
+    mito::benchmark::run("allocations/axpy", 1000000, [&]() {
+        vector_t<3> z = 2.0 * x + y;
+        mito::benchmark::doNotOptimize(z);
+    });
+    mito::benchmark::run("allocations/matvec", 1000000, [&]() {
+        vector_t<3> z = A * x - y;
+        mito::benchmark::doNotOptimize(z);
+    });
+
+    // integration of a scalar and a vector field on a structured mesh
+    constexpr int n = 100;
+    mito::benchmark::StructuredMesh mesh(n);
+    mito::ElementSet elementSet(mesh.elements(), mesh.coordinatesMap());
+    mito::Integrator<GAUSS, 2 /* degree of exactness */, mito::ElementSet<mito::triangle_t, 2>>
+        integrator(elementSet);
+
+    mito::ScalarField<2> scalar([](const vector_t<2> & x) { return cos(x[0] * x[1]); });
+    mito::benchmark::run(
+        "allocations/integrate-scalar", 10,
+        [&]() { mito::benchmark::doNotOptimize(integrator.integrate(scalar)); },
+        elementSet.nElements());
+
+    mito::VectorField<2, 2> vector(
+        [](const vector_t<2> & x) { return vector_t<2> { x[0] * x[1], x[0] * x[0] }; });
+    mito::benchmark::run(
+        "allocations/integrate-vector", 10,
+        [&]() { mito::benchmark::doNotOptimize(integrator.integrate(vector)); },
+        elementSet.nElements());
+
+    // all done
+    return 0;
+}
+
+// end of file
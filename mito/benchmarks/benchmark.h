@@ -0,0 +1,252 @@
+// code guard
+#if !defined(mito_benchmarks_benchmark_h)
+#define mito_benchmarks_benchmark_h
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+// NOTE: this header replaces the global allocation functions in order to count heap allocations,
+//       so it must be included by exactly one translation unit of each benchmark executable
+
+namespace mito { namespace benchmark {
+
+    // the number of heap allocations performed so far by the process
+    inline std::atomic<long> allocations = 0;
+
+    // prevent the compiler from optimizing away the computation of {value}
+    template <typename T>
+    inline void doNotOptimize(const T & value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // a wall clock timer that also records the heap allocations performed while running
+    class Timer {
+
+        using clock_t = std::chrono::steady_clock;
+
+      public:
+        inline Timer() : _start(clock_t::now()), _allocations(benchmark::allocations.load()) {}
+
+        // restart the timer
+        inline void reset()
+        {
+            _start = clock_t::now();
+            _allocations = benchmark::allocations.load();
+        }
+
+        // the seconds elapsed since the timer was (re)started
+        inline double seconds() const
+        {
+            return std::chrono::duration<double>(clock_t::now() - _start).count();
+        }
+
+        // the heap allocations performed since the timer was (re)started
+        inline long allocations() const { return benchmark::allocations.load() - _allocations; }
+
+      private:
+        clock_t::time_point _start;
+        long _allocations;
+    };
+
+    /**
+     * @brief Reports the measurement of a benchmark as one line of JSON on the standard output
+     *
+     * @param name the name of the benchmark
+     * @param ops the number of operations (calls of the kernel) that were timed
+     * @param seconds the time spent in the timed operations
+     * @param allocations the heap allocations performed by the timed operations
+     * @param items the number of items (e.g. elements, points) processed by each operation
+     */
+    inline void report(
+        const std::string & name, long ops, double seconds, long allocations, long items = 1)
+    {
+        std::cout << "{\"benchmark\": \"" << name << "\", \"ops\": " << ops
+                  << ", \"ns/op\": " << 1.e9 * seconds / ops
+                  << ", \"items/s\": " << items * ops / seconds
+                  << ", \"allocations/op\": " << double(allocations) / ops
+                  << ", \"allocations/item\": " << double(allocations) / (ops * items) << "}"
+                  << std::endl;
+
+        // all done
+        return;
+    }
+
+    /**
+     * @brief Times {ops} calls of {kernel} (after one untimed warm-up call) and reports the result
+     *
+     * @param name the name of the benchmark
+     * @param ops the number of timed calls of the kernel
+     * @param kernel the callable to benchmark
+     * @param items the number of items (e.g. elements, points) processed by each call
+     */
+    template <typename F>
+    inline void run(const std::string & name, long ops, F && kernel, long items = 1)
+    {
+        // warm up
+        kernel();
+
+        // time {ops} calls of the kernel
+        Timer timer;
+        for (long op = 0; op < ops; ++op) {
+            kernel();
+        }
+        double seconds = timer.seconds();
+        long allocations = timer.allocations();
+
+        // report
+        report(name, ops, seconds, allocations, items);
+
+        // all done
+        return;
+    }
+
+}}    // namespace mito::benchmark
+
+// replacement of the global allocation functions counting the heap allocations: every allocation
+// function (plain, array, aligned and nothrow) takes its memory from {malloc} or {aligned_alloc},
+// and every deallocation function gives it back with {free}, so that each pair matches; they are
+// kept out of line so that the compiler does not pair an inlined {free} with a call to the
+// allocation function it treats as the builtin one
+[[gnu::noinline]] void *
+operator new(std::size_t size)
+{
+    ++mito::benchmark::allocations;
+    if (void * ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void *
+operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+[[gnu::noinline]] void *
+operator new(std::size_t size, std::align_val_t align)
+{
+    ++mito::benchmark::allocations;
+    // round the size up to a multiple of the alignment, as required by {aligned_alloc}
+    std::size_t alignment = static_cast<std::size_t>(align);
+    std::size_t bytes = (size + alignment - 1) / alignment * alignment;
+    if (void * ptr = std::aligned_alloc(alignment, bytes ? bytes : alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void *
+operator new[](std::size_t size, std::align_val_t align)
+{
+    return operator new(size, align);
+}
+
+[[gnu::noinline]] void *
+operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    ++mito::benchmark::allocations;
+    return std::malloc(size ? size : 1);
+}
+
+[[gnu::noinline]] void *
+operator new[](std::size_t size, const std::nothrow_t & tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+[[gnu::noinline]] void *
+operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+    ++mito::benchmark::allocations;
+    std::size_t alignment = static_cast<std::size_t>(align);
+    std::size_t bytes = (size + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, bytes ? bytes : alignment);
+}
+
+[[gnu::noinline]] void *
+operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t & tag) noexcept
+{
+    return operator new(size, align, tag);
+}
+
+[[gnu::noinline]] void
+operator delete(void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete[](void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete(void * ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete[](void * ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete(void * ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete[](void * ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete(void * ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete[](void * ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete(void * ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete[](void * ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete(void * ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete[](void * ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+#endif    // mito_benchmarks_benchmark_h
+
+// end of file
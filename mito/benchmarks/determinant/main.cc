@@ -0,0 +1,146 @@
+#include "../benchmark.h"
+#include "../../mito.h"
+
+using mito::vector_t;
+using mito::tensor_t;
+using mito::real;
+
+// the closed forms of the determinant and of the inverse (D <= 4) against the generic LU
+// factorization, which must not be slower where both are available
+
+// a well-conditioned tensor for each {k}
+template <int D>
+tensor_t<D>
+sample(int k)
+{
+    tensor_t<D> A;
+    for (int i = 0; i < D; ++i) {
+        for (int j = 0; j < D; ++j) {
+            A[i * D + j] = i == j ? D + 0.001 * k : 1.0 / (1 + i + j);
+        }
+    }
+    return A;
+}
+
+template <int D>
+void
+determinant(const std::string & name, int n)
+{
+    std::vector<tensor_t<D>> A(n);
+    for (int k = 0; k < n; ++k) {
+        A[k] = sample<D>(k);
+    }
+    std::vector<real> det(n);
+
+    if constexpr (D <= 4) {
+        mito::benchmark::run(
+            name + "/closed-form", 100,
+            [&]() {
+                for (int k = 0; k < n; ++k) {
+                    det[k] = mito::ComputeDeterminant(A[k]);
+                }
+                mito::benchmark::doNotOptimize(det.data());
+            },
+            n);
+    }
+
+    mito::benchmark::run(
+        name + "/generic", 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                det[k] = mito::ComputeDeterminant<D, real>(A[k]);
+            }
+            mito::benchmark::doNotOptimize(det.data());
+        },
+        n);
+
+    // all done
+    return;
+}
+
+template <int D>
+void
+inverse(const std::string & name, int n)
+{
+    std::vector<tensor_t<D>> A(n), invA(n);
+    for (int k = 0; k < n; ++k) {
+        A[k] = sample<D>(k);
+    }
+    std::vector<real> det(n);
+
+    if constexpr (D <= 3) {
+        mito::benchmark::run(
+            name + "/closed-form", 100,
+            [&]() {
+                for (int k = 0; k < n; ++k) {
+                    det[k] = mito::ComputeInverse(A[k], invA[k]);
+                }
+                mito::benchmark::doNotOptimize(invA.data());
+            },
+            n);
+    }
+
+    mito::benchmark::run(
+        name + "/generic", 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                det[k] = mito::ComputeInverse<D, real>(A[k], invA[k]);
+            }
+            mito::benchmark::doNotOptimize(invA.data());
+        },
+        n);
+
+    // all done
+    return;
+}
+
+template <int D>
+void
+solve(const std::string & name, int n)
+{
+    std::vector<tensor_t<D>> A(n);
+    std::vector<vector_t<D>> b(n), x(n);
+    for (int k = 0; k < n; ++k) {
+        A[k] = sample<D>(k);
+        for (int i = 0; i < D; ++i) {
+            b[k][i] = k + i;
+        }
+    }
+
+    mito::benchmark::run(
+        name, 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                x[k] = mito::Solve(A[k], b[k]);
+            }
+            mito::benchmark::doNotOptimize(x.data());
+        },
+        n);
+
+    // all done
+    return;
+}
+
+int
+main()
+{
+    constexpr int n = 10000;
+
+    determinant<2>("determinant/2", n);
+    determinant<3>("determinant/3", n);
+    determinant<4>("determinant/4", n);
+    determinant<5>("determinant/5", n);
+    determinant<6>("determinant/6", n);
+
+    inverse<2>("inverse/2", n);
+    inverse<3>("inverse/3", n);
+    inverse<4>("inverse/4", n);
+
+    solve<3>("solve/3", n);
+    solve<6>("solve/6", n);
+
+    // all done
+    return 0;
+}
+
+// end of file
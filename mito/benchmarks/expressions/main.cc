@@ -0,0 +1,216 @@
+#include "../benchmark.h"
+#include "../../mito.h"
+
+using mito::vector_t;
+using mito::tensor_t;
+using mito::real;
+
+// the eager path: every operation builds a full grid temporary
+namespace eager {
+
+    template <class G>
+    G sum(const G & y1, const G & y2)
+    {
+        G result;
+        for (int i = 0; i < G::S; ++i) {
+            result[i] = y1[i] + y2[i];
+        }
+        return result;
+    }
+
+    template <class G>
+    G difference(const G & y1, const G & y2)
+    {
+        G result;
+        for (int i = 0; i < G::S; ++i) {
+            result[i] = y1[i] - y2[i];
+        }
+        return result;
+    }
+
+    template <class G>
+    G scale(real a, const G & y)
+    {
+        G result;
+        for (int i = 0; i < G::S; ++i) {
+            result[i] = a * y[i];
+        }
+        return result;
+    }
+
+    template <int D>
+    vector_t<D> product(const tensor_t<D> & A, const vector_t<D> & x)
+    {
+        vector_t<D> result;
+        for (int i = 0; i < D; ++i) {
+            for (int j = 0; j < D; ++j) {
+                result[i] += A[i * D + j] * x[j];
+            }
+        }
+        return result;
+    }
+
+    template <int D>
+    tensor_t<D> product(const tensor_t<D> & A, const tensor_t<D> & B)
+    {
+        tensor_t<D> result;
+        for (int i = 0; i < D; ++i) {
+            for (int j = 0; j < D; ++j) {
+                for (int k = 0; k < D; ++k) {
+                    result[i * D + j] += A[i * D + k] * B[k * D + j];
+                }
+            }
+        }
+        return result;
+    }
+
+    template <int D>
+    tensor_t<D> transpose(const tensor_t<D> & A)
+    {
+        tensor_t<D> result;
+        for (int i = 0; i < D; ++i) {
+            for (int j = 0; j < D; ++j) {
+                result[j * D + i] = A[i * D + j];
+            }
+        }
+        return result;
+    }
+}
+
+// a * x + b * y - z on arrays of grids, with the lazy and the eager operators
+template <class G>
+void
+axpbymz(const std::string & name, int n)
+{
+    std::vector<G> x(n), y(n), z(n), w(n);
+    for (int k = 0; k < n; ++k) {
+        for (int i = 0; i < G::S; ++i) {
+            x[k][i] = k + i;
+            y[k][i] = k - i;
+            z[k][i] = 0.5 * i;
+        }
+    }
+    const real a = 2.0;
+    const real b = -1.5;
+
+    mito::benchmark::run(
+        name + "/lazy", 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                w[k] = a * x[k] + b * y[k] - z[k];
+            }
+            mito::benchmark::doNotOptimize(w.data());
+        },
+        n);
+
+    mito::benchmark::run(
+        name + "/eager", 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                w[k] = eager::difference(
+                    eager::sum(eager::scale(a, x[k]), eager::scale(b, y[k])), z[k]);
+            }
+            mito::benchmark::doNotOptimize(w.data());
+        },
+        n);
+
+    // all done
+    return;
+}
+
+// A * x + y on arrays of grids, with the lazy and the eager operators
+template <int D>
+void
+matvec(const std::string & name, int n)
+{
+    std::vector<tensor_t<D>> A(n);
+    std::vector<vector_t<D>> x(n), y(n), w(n);
+    for (int k = 0; k < n; ++k) {
+        for (int i = 0; i < D; ++i) {
+            x[k][i] = k + i;
+            y[k][i] = k - i;
+            for (int j = 0; j < D; ++j) {
+                A[k][i * D + j] = i == j ? 2.0 : 0.1 * j;
+            }
+        }
+    }
+
+    mito::benchmark::run(
+        name + "/lazy", 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                w[k] = A[k] * x[k] + y[k];
+            }
+            mito::benchmark::doNotOptimize(w.data());
+        },
+        n);
+
+    mito::benchmark::run(
+        name + "/eager", 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                w[k] = eager::sum(eager::product(A[k], x[k]), y[k]);
+            }
+            mito::benchmark::doNotOptimize(w.data());
+        },
+        n);
+
+    // all done
+    return;
+}
+
+// A^T * B + C on arrays of tensors, with the lazy and the eager operators
+template <int D>
+void
+matmat(const std::string & name, int n)
+{
+    std::vector<tensor_t<D>> A(n), B(n), C(n), W(n);
+    for (int k = 0; k < n; ++k) {
+        for (int i = 0; i < D * D; ++i) {
+            A[k][i] = k + i;
+            B[k][i] = k - i;
+            C[k][i] = 0.5 * i;
+        }
+    }
+
+    mito::benchmark::run(
+        name + "/lazy", 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                W[k] = mito::dot(mito::transpose(A[k]), B[k]) + C[k];
+            }
+            mito::benchmark::doNotOptimize(W.data());
+        },
+        n);
+
+    mito::benchmark::run(
+        name + "/eager", 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                W[k] = eager::sum(eager::product(eager::transpose(A[k]), B[k]), C[k]);
+            }
+            mito::benchmark::doNotOptimize(W.data());
+        },
+        n);
+
+    // all done
+    return;
+}
+
+int
+main()
+{
+    constexpr int n = 100000;
+
+    axpbymz<vector_t<3>>("expressions/axpbymz-vector3", n);
+    axpbymz<tensor_t<3>>("expressions/axpbymz-tensor3", n);
+    matvec<2>("expressions/matvec-2", n);
+    matvec<3>("expressions/matvec-3", n);
+    matmat<2>("expressions/matmat-2", n);
+    matmat<3>("expressions/matmat-3", n);
+
+    // all done
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,196 @@
+#include <cmath>
+#include "../benchmark.h"
+#include "../../math/ExpressionField.h"
+#include "../../math/Field.h"
+#include "../../math/StaticFunction.h"
+
+using mito::Function;
+using mito::vector_t;
+using mito::real;
+
+// evaluation of functions, of their algebraic compositions and of fields (pointwise, on vectors
+// of points and on quadrature fields), and of the gradient and divergence fields
+
+// evaluate {f} at {points} and accumulate the result
+template <class F>
+void
+evaluate(const std::string & name, const F & f, const std::vector<vector_t<2>> & points)
+{
+    mito::benchmark::run(
+        name, 100,
+        [&]() {
+            real sum = 0.0;
+            for (const auto & x : points) {
+                sum += real(f(x));
+            }
+            mito::benchmark::doNotOptimize(sum);
+        },
+        points.size());
+
+    // all done
+    return;
+}
+
+int
+main()
+{
+    constexpr int n = 10000;
+    std::vector<vector_t<2>> points(n);
+    for (int k = 0; k < n; ++k) {
+        points[k] = vector_t<2> { real(k) / n, 1.0 - real(k) / n };
+    }
+
+    // functions
+    Function<vector_t<2>> f([](const vector_t<2> & x) { return cos(x[0] * x[1]); });
+    Function<vector_t<2>> g([](const vector_t<2> & x) { return x[0] + x[1]; });
+    evaluate("fields/function", f, points);
+    evaluate("fields/function-sum", f + g, points);
+    evaluate("fields/function-composition", 2.0 * f * g - g / 3.0, points);
+
+    // the same functions, with statically typed compositions
+    auto fs = mito::function<vector_t<2>>([](const vector_t<2> & x) { return cos(x[0] * x[1]); });
+    auto gs = mito::function<vector_t<2>>([](const vector_t<2> & x) { return x[0] + x[1]; });
+    evaluate("fields/static-function", fs, points);
+    evaluate("fields/static-sum", fs + gs, points);
+    evaluate("fields/static-composition", 2.0 * fs * gs - gs / 3.0, points);
+
+    // fields and their derivatives
+    Function<vector_t<2>> Dfx([](const vector_t<2> & x) { return -sin(x[0] * x[1]) * x[1]; });
+    Function<vector_t<2>> Dfy([](const vector_t<2> & x) { return -sin(x[0] * x[1]) * x[0]; });
+    mito::ScalarField<2> field(f, { Dfx, Dfy });
+    evaluate("fields/field", field, points);
+    auto gradient = mito::grad(field);
+    evaluate("fields/grad", [&gradient](const vector_t<2> & x) { return gradient(x)[0]; }, points);
+    // the same field, differentiated automatically
+    mito::ScalarField<2> fieldAD(mito::autodiff, [](const auto & x) { return cos(x[0] * x[1]); });
+    auto gradientAD = mito::grad(fieldAD);
+    evaluate(
+        "fields/grad-ad", [&gradientAD](const vector_t<2> & x) { return gradientAD(x)[0]; },
+        points);
+    mito::VectorField<2, 2> vectorField(
+        Function<vector_t<2>, vector_t<2>>(
+            [](const vector_t<2> & x) { return vector_t<2> { x[0] * x[1], x[1] }; }),
+        { Function<vector_t<2>, vector_t<2>>(
+              [](const vector_t<2> & x) { return vector_t<2> { x[1], 0.0 }; }),
+          Function<vector_t<2>, vector_t<2>>(
+              [](const vector_t<2> & x) { return vector_t<2> { x[0], 1.0 }; }) });
+    auto divergence = mito::div(vectorField);
+    evaluate("fields/div", divergence, points);
+
+    // the differential operators of a 3D vector field on a vector of points: the divergence
+    // evaluated partial by partial at each point, against the fused operators
+    auto u = [](const auto & x) {
+        auto y = x;
+        y[0] = x[1] * x[2];
+        y[1] = sin(x[0]) + x[2];
+        y[2] = x[0] * x[0] * x[1];
+        return y;
+    };
+    using function3D_t = Function<vector_t<3>, vector_t<3>>;
+    mito::VectorField<3, 3> field3D(
+        function3D_t(u),
+        { function3D_t([](const vector_t<3> & x) {
+              return vector_t<3> { 0.0, cos(x[0]), 2.0 * x[0] * x[1] };
+          }),
+          function3D_t(
+              [](const vector_t<3> & x) { return vector_t<3> { x[2], 0.0, x[0] * x[0] }; }),
+          function3D_t([](const vector_t<3> & x) { return vector_t<3> { x[1], 1.0, 0.0 }; }) });
+    mito::VectorField<3, 3> field3DAD(mito::autodiff, u);
+    // hide the partial derivatives from the optimizer, as those of a field built elsewhere would
+    // be (otherwise, the evaluation partial by partial inlines them and skips the components it
+    // does not read)
+    mito::benchmark::doNotOptimize(field3D);
+    std::vector<vector_t<3>> points3D(n);
+    for (int k = 0; k < n; ++k) {
+        points3D[k] = vector_t<3> { real(k) / n, 1.0 - real(k) / n, 0.5 };
+    }
+    mito::benchmark::run(
+        "fields/div-per-partial", 100,
+        [&]() {
+            std::vector<real> values(n);
+            for (int k = 0; k < n; ++k) {
+                values[k] = field3D.Df(0)(points3D[k])[0] + field3D.Df(1)(points3D[k])[1]
+                          + field3D.Df(2)(points3D[k])[2];
+            }
+            mito::benchmark::doNotOptimize(values);
+        },
+        n);
+    auto div3D = mito::div(field3D);
+    mito::benchmark::run(
+        "fields/div-fused", 100, [&]() { mito::benchmark::doNotOptimize(div3D(points3D)); }, n);
+    auto div3DAD = mito::div(field3DAD);
+    mito::benchmark::run(
+        "fields/div-fused-ad", 100, [&]() { mito::benchmark::doNotOptimize(div3DAD(points3D)); },
+        n);
+    auto curl3D = mito::curl(field3D);
+    mito::benchmark::run(
+        "fields/curl-fused", 100, [&]() { mito::benchmark::doNotOptimize(curl3D(points3D)); }, n);
+    auto jacobian3D = mito::jacobian(field3D);
+    mito::benchmark::run(
+        "fields/jacobian-fused", 100,
+        [&]() { mito::benchmark::doNotOptimize(jacobian3D(points3D)); }, n);
+
+    // a field on a vector of points and on a quadrature field
+    mito::benchmark::run(
+        "fields/field-vector", 100, [&]() { mito::benchmark::doNotOptimize(field(points)); }, n);
+
+    // a composition on a vector of points, with pointwise and with batch functions
+    mito::ScalarField<2> composition(2.0 * f * g - g / 3.0);
+    mito::benchmark::run(
+        "fields/composition-vector", 100,
+        [&]() { mito::benchmark::doNotOptimize(composition(points)); }, n);
+    Function<vector_t<2>> fb([](const vector_t<2> * x, mito::scalar_t<real> * y, int n) {
+        for (int k = 0; k < n; ++k) {
+            y[k] = cos(x[k][0] * x[k][1]);
+        }
+    });
+    Function<vector_t<2>> gb([](const vector_t<2> * x, mito::scalar_t<real> * y, int n) {
+        for (int k = 0; k < n; ++k) {
+            y[k] = x[k][0] + x[k][1];
+        }
+    });
+    mito::ScalarField<2> batchComposition(2.0 * fb * gb - gb / 3.0);
+    mito::benchmark::run(
+        "fields/batch-composition-vector", 100,
+        [&]() { mito::benchmark::doNotOptimize(batchComposition(points)); }, n);
+    // the same composition, compiled at runtime from its expression
+    mito::ScalarField<2> expression(
+        mito::expression<vector_t<2>>("2 * cos(x0 * x1) * (x0 + x1) - (x0 + x1) / 3").f());
+    mito::benchmark::run(
+        "fields/expression-vector", 100,
+        [&]() { mito::benchmark::doNotOptimize(expression(points)); }, n);
+    // ... and a composition depending on time, at a new time at each evaluation
+    auto timeExpression =
+        mito::expression<vector_t<2>>("2 * cos(x0 * x1) * (x0 + x1) - (x0 + x1) / 3 * t");
+    real time = 0.0;
+    mito::benchmark::run(
+        "fields/expression-time-vector", 100,
+        [&]() { mito::benchmark::doNotOptimize(timeExpression(points, time += 0.1)); }, n);
+    mito::benchmark::run(
+        "fields/expression-time-pointwise", 100,
+        [&]() {
+            time += 0.1;
+            for (const auto & x : points) {
+                mito::benchmark::doNotOptimize(timeExpression(x, time));
+            }
+        },
+        n);
+    mito::benchmark::run(
+        "fields/grad-vector", 100, [&]() { mito::benchmark::doNotOptimize(gradient(points)); }, n);
+
+    constexpr int Q = 3;
+    mito::quadrature_field_t<Q, vector_t<2>> quadraturePoints(n / Q);
+    for (int e = 0; e < n / Q; ++e) {
+        for (int q = 0; q < Q; ++q) {
+            quadraturePoints(e, q) = points[e * Q + q];
+        }
+    }
+    mito::benchmark::run(
+        "fields/field-quadrature", 100,
+        [&]() { mito::benchmark::doNotOptimize(field(quadraturePoints)); }, (n / Q) * Q);
+
+    // all done
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,52 @@
+#include "../benchmark.h"
+#include "../../materials/Gent.h"
+
+using mito::vector_t;
+using mito::tensor_t;
+using mito::real;
+
+// the Gent constitutive update on arrays of deformation gradients
+
+template <int D>
+void
+constitutive(const std::string & name, int n)
+{
+    mito::Gent material(1.0 /*rho*/, 1.0 /*kappa*/, 1.0 /*mu*/, 10.0 /*Jm*/);
+
+    std::vector<vector_t<D>> u(n);
+    std::vector<tensor_t<D>> Du(n), P(n);
+    for (int k = 0; k < n; ++k) {
+        for (int i = 0; i < D; ++i) {
+            for (int j = 0; j < D; ++j) {
+                Du[k][i * D + j] = (i == j ? 1.0 : 0.0) + 0.01 * ((k + i + 2 * j) % 7);
+            }
+        }
+    }
+
+    mito::benchmark::run(
+        name, 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                material.Constitutive<D>(u[k], Du[k], P[k]);
+            }
+            mito::benchmark::doNotOptimize(P.data());
+        },
+        n);
+
+    // all done
+    return;
+}
+
+int
+main()
+{
+    constexpr int n = 10000;
+
+    constitutive<2>("gent/constitutive-2", n);
+    constitutive<3>("gent/constitutive-3", n);
+
+    // all done
+    return 0;
+}
+
+// end of file
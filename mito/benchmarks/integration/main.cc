@@ -0,0 +1,136 @@
+#include <cmath>
+#include <filesystem>
+#include "../benchmark.h"
+#include "../structured_mesh.h"
+#include "../../math/Field.h"
+#include "../../math/TimeDependentField.h"
+#include "../../mesh/ElementSet.h"
+#include "../../mesh/Mesh.h"
+#include "../../mesh/StructuredMeshFile.h"
+#include "../../quadrature/Integrator.h"
+
+using mito::vector_t;
+using mito::real;
+using mito::GAUSS;
+
+// setup of the integrator (quadrature point coordinates) and integration of a scalar and of a
+// vector field on structured triangulations of the unit square of increasing size (also memoizing
+// the values of the field), and integration of a separable time dependent field over time steps,
+// evaluated at each step or cached, and setup of the integrator on meshes loaded from shuffled
+// files, with their vertices and elements in the order of the file or along a Hilbert curve
+
+using integrator_t =
+    mito::Integrator<GAUSS, 2 /* degree of exactness */, mito::ElementSet<mito::triangle_t, 2>>;
+
+int
+main()
+{
+    mito::ScalarField<2> scalar([](const vector_t<2> & x) { return cos(x[0] * x[1]); });
+    mito::VectorField<2, 2> vector(
+        [](const vector_t<2> & x) { return vector_t<2> { x[0] * x[1], x[0] * x[0] }; });
+
+    for (int n : { 10, 30, 100, 300 }) {
+        mito::benchmark::StructuredMesh mesh(n);
+        mito::ElementSet elementSet(mesh.elements(), mesh.coordinatesMap());
+        const std::string size = std::to_string(n);
+        const int ops = n < 300 ? 100 : 10;
+
+        mito::benchmark::run(
+            "integration/element-set-" + size, ops,
+            [&]() {
+                mito::ElementSet elements(mesh.elements(), mesh.coordinatesMap());
+                mito::benchmark::doNotOptimize(elements.jacobian(0));
+            },
+            elementSet.nElements());
+
+        mito::benchmark::run(
+            "integration/setup-" + size, ops,
+            [&]() {
+                integrator_t integrator(elementSet);
+                mito::benchmark::doNotOptimize(integrator);
+            },
+            elementSet.nElements());
+
+        integrator_t integrator(elementSet);
+        mito::benchmark::run(
+            "integration/scalar-" + size, ops,
+            [&]() { mito::benchmark::doNotOptimize(integrator.integrate(scalar)); },
+            elementSet.nElements());
+        mito::benchmark::run(
+            "integration/vector-" + size, ops,
+            [&]() { mito::benchmark::doNotOptimize(integrator.integrate(vector)); },
+            elementSet.nElements());
+        integrator_t memoizingIntegrator(elementSet);
+        memoizingIntegrator.memoize();
+        mito::benchmark::run(
+            "integration/scalar-memoized-" + size, ops,
+            [&]() { mito::benchmark::doNotOptimize(memoizingIntegrator.integrate(scalar)); },
+            elementSet.nElements());
+
+        constexpr int steps = 10;
+        mito::benchmark::run(
+            "integration/steps-evaluated-" + size, ops,
+            [&]() {
+                for (int step = 0; step < steps; ++step) {
+                    real t = 0.1 * step;
+                    mito::ScalarField<2> source(
+                        [t](const vector_t<2> & x) { return sin(t) * cos(x[0] * x[1]); });
+                    mito::benchmark::doNotOptimize(integrator.integrate(source));
+                }
+            },
+            steps * elementSet.nElements());
+        mito::TimeDependentField<vector_t<2>> source(scalar, [](real t) { return sin(t); });
+        mito::CachedField cached(source, integrator.coordinates());
+        mito::benchmark::run(
+            "integration/steps-cached-" + size, ops,
+            [&]() {
+                for (int step = 0; step < steps; ++step) {
+                    real t = 0.1 * step;
+                    mito::benchmark::doNotOptimize(integrator.integrate(cached(t)));
+                }
+            },
+            steps * elementSet.nElements());
+    }
+
+    for (int n : { 300, 1000 }) {
+        // a mesh file with the vertices randomly numbered and the elements in random order
+        std::string fileName =
+            (std::filesystem::temp_directory_path() / ("mito-benchmark-shuffled-"
+                                                       + std::to_string(n) + ".summit"))
+                .string();
+        mito::writeStructuredMesh(fileName, n, true /* shuffle */);
+        const std::string size = std::to_string(n);
+        const int ops = n < 1000 ? 10 : 3;
+
+        for (auto [name, ordering] : { std::pair { "file-order", mito::Ordering::file },
+                                       std::pair { "hilbert", mito::Ordering::hilbert } }) {
+            mito::Mesh<2> mesh(fileName, ordering);
+            mito::ElementSet elementSet(
+                mesh.entities<2>(), mesh.elementsVertices(), mesh.coordinates());
+
+            mito::benchmark::run(
+                "integration/element-set-shuffled-" + std::string(name) + "-" + size, ops,
+                [&]() {
+                    mito::ElementSet elements(
+                        mesh.entities<2>(), mesh.elementsVertices(), mesh.coordinates());
+                    mito::benchmark::doNotOptimize(elements.jacobian(0));
+                },
+                elementSet.nElements());
+
+            mito::benchmark::run(
+                "integration/setup-shuffled-" + std::string(name) + "-" + size, ops,
+                [&]() {
+                    integrator_t integrator(elementSet);
+                    mito::benchmark::doNotOptimize(integrator);
+                },
+                elementSet.nElements());
+        }
+
+        std::filesystem::remove(fileName);
+    }
+
+    // all done
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,172 @@
+#include <filesystem>
+#include <set>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include "../benchmark.h"
+#include "../../mesh/Mesh.h"
+#include "../../mesh/StructuredMeshFile.h"
+
+// loading of structured triangulations of the unit square of increasing size from .summit files
+// (in the order of the file and renumbered along a Hilbert curve) and from binary mesh files, and
+// the heap memory held by the loaded meshes
+
+// the bytes of heap memory in use (including the bookkeeping of the allocator and the large blocks
+// mapped on their own), if available
+long
+heapBytes()
+{
+#if defined(__GLIBC__)
+    return mallinfo2().uordblks + mallinfo2().hblkhd;
+#else
+    return 0;
+#endif
+}
+
+int
+main()
+{
+    for (int n : { 10, 30, 100, 300, 1000 }) {
+        // write the mesh file
+        std::string fileName =
+            (std::filesystem::temp_directory_path() / ("mito-benchmark-" + std::to_string(n)
+                                                       + ".summit"))
+                .string();
+        mito::writeStructuredMesh(fileName, n);
+
+        mito::benchmark::run(
+            "mesh/load-" + std::to_string(n), n < 300 ? 10 : 1,
+            [&]() {
+                mito::Mesh<2> mesh(fileName);
+                mito::benchmark::doNotOptimize(mesh.nEntities<2>());
+            },
+            2 * n * n /* elements */);
+
+        // the loading with the vertices and the elements renumbered along a Hilbert curve
+        mito::benchmark::run(
+            "mesh/load-hilbert-" + std::to_string(n), n < 300 ? 10 : 1,
+            [&]() {
+                mito::Mesh<2> mesh(fileName, mito::Ordering::hilbert);
+                mito::benchmark::doNotOptimize(mesh.nEntities<2>());
+            },
+            2 * n * n /* elements */);
+
+        // the parsing of the mesh file alone, on one thread and on all threads
+        mito::ThreadPool serial(1);
+        mito::ThreadPool pool;
+        mito::benchmark::run(
+            "mesh/parse-" + std::to_string(n), n < 300 ? 10 : 1,
+            [&]() {
+                mito::SummitFile<2> file(fileName, serial);
+                mito::benchmark::doNotOptimize(file.good());
+            },
+            2 * n * n /* elements */);
+        mito::benchmark::run(
+            "mesh/parse-" + std::to_string(pool.threads()) + "-threads-" + std::to_string(n),
+            n < 300 ? 10 : 1,
+            [&]() {
+                mito::SummitFile<2> file(fileName, pool);
+                mito::benchmark::doNotOptimize(file.good());
+            },
+            2 * n * n /* elements */);
+
+        // the same mesh loaded from the binary format
+        std::string binaryFileName = fileName.substr(0, fileName.size() - 7) + ".mito";
+        mito::convertMesh<2>(fileName, binaryFileName);
+        mito::benchmark::run(
+            "mesh/load-binary-" + std::to_string(n), n < 300 ? 10 : 1,
+            [&]() {
+                mito::Mesh<2> mesh(binaryFileName);
+                mito::benchmark::doNotOptimize(mesh.nEntities<2>());
+            },
+            2 * n * n /* elements */);
+        std::filesystem::remove(binaryFileName);
+
+        // the heap memory held by the mesh
+        long before = heapBytes();
+        {
+            mito::Mesh<2> mesh(fileName);
+            long bytes = heapBytes() - before;
+            std::cout << "{\"benchmark\": \"mesh/memory-" << n << "\", \"bytes\": " << bytes
+                      << ", \"bytes/item\": " << double(bytes) / (2 * n * n) << "}" << std::endl;
+
+            // the memory of the topology as pointers (the compositions of the simplices) and as
+            // indices
+            long pointers = 0;
+            pointers += mesh.nEntities<1>() * 2 * sizeof(mito::vertex_t *);
+            pointers += mesh.nEntities<2>() * 3 * sizeof(mito::segment_t *);
+            std::cout << "{\"benchmark\": \"mesh/topology-memory-" << n
+                      << "\", \"pointers\": " << pointers
+                      << ", \"indices\": " << mesh.topology().bytes() << "}" << std::endl;
+
+            // the vertices of the elements, through the edges, as pointers and as indices
+            const mito::vertex_t * first = mesh.entities<0>()[0];
+            mito::benchmark::run(
+                "mesh/element-vertices-pointers-" + std::to_string(n), n < 300 ? 100 : 10,
+                [&]() {
+                    long sum = 0;
+                    for (const auto & element : mesh.entities<2>()) {
+                        std::set<const mito::vertex_t *> vertices;
+                        element->getVertices(vertices);
+                        for (const auto & vertex : vertices) {
+                            sum += vertex - first;
+                        }
+                    }
+                    mito::benchmark::doNotOptimize(sum);
+                },
+                2 * n * n /* elements */);
+            mito::benchmark::run(
+                "mesh/element-vertices-indices-" + std::to_string(n), n < 300 ? 100 : 10,
+                [&]() {
+                    long sum = 0;
+                    const auto & topology = mesh.topology();
+                    for (int e = 0; e < topology.nEntities<2>(); ++e) {
+                        for (auto v : topology.vertices<2>(e)) {
+                            sum += v;
+                        }
+                    }
+                    mito::benchmark::doNotOptimize(sum);
+                },
+                2 * n * n /* elements */);
+        }
+
+        // clean up
+        std::filesystem::remove(fileName);
+    }
+
+    // tetrahedral meshes of the unit cube
+    for (int n : { 10, 30, 80 }) {
+        // write the mesh file
+        std::string fileName =
+            (std::filesystem::temp_directory_path() / ("mito-benchmark-tet-" + std::to_string(n)
+                                                       + ".summit"))
+                .string();
+        mito::writeStructuredTetMesh(fileName, n);
+
+        mito::benchmark::run(
+            "mesh/load-tet-" + std::to_string(n), n < 30 ? 10 : 1,
+            [&]() {
+                mito::Mesh<3> mesh(fileName);
+                mito::benchmark::doNotOptimize(mesh.nEntities<3>());
+            },
+            6 * n * n * n /* elements */);
+
+        // the heap memory held by the mesh
+        long before = heapBytes();
+        {
+            mito::Mesh<3> mesh(fileName);
+            long bytes = heapBytes() - before;
+            std::cout << "{\"benchmark\": \"mesh/memory-tet-" << n << "\", \"bytes\": " << bytes
+                      << ", \"bytes/item\": " << double(bytes) / (6 * n * n * n) << "}"
+                      << std::endl;
+        }
+
+        // clean up
+        std::filesystem::remove(fileName);
+    }
+
+    // all done
+    return 0;
+}
+
+// end of file
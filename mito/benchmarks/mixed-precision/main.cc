@@ -0,0 +1,91 @@
+#include <cmath>
+#include "../benchmark.h"
+#include "../structured_mesh.h"
+#include "../../math/Field.h"
+#include "../../mesh/ElementSet.h"
+#include "../../quadrature/Integrator.h"
+
+using mito::vector_t;
+using mito::real;
+using mito::GAUSS;
+
+// integration of a scalar and of a vector field with the fields evaluated and stored in double and
+// in single precision (the integrals are accumulated in double precision in both cases): reports
+// the throughput of both and the relative error of the mixed precision integrals
+
+template <typename T>
+using integrator_t = mito::Integrator<
+    GAUSS, 2 /* degree of exactness */, mito::ElementSet<mito::triangle_t, 2>, T>;
+
+template <typename T, class Y>
+auto
+integrate(
+    const std::string & name, integrator_t<T> & integrator, const Y & field, int nElements)
+{
+    mito::benchmark::run(
+        name, 10, [&]() { mito::benchmark::doNotOptimize(integrator.integrate(field)); },
+        nElements);
+    return integrator.integrate(field);
+}
+
+// report the relative error of {approximation} with respect to {reference}
+template <class G>
+void
+error(const std::string & name, const G & approximation, const G & reference)
+{
+    std::cout << "{\"benchmark\": \"" << name << "\", \"relative error\": "
+              << std::sqrt((approximation - reference) * (approximation - reference))
+                     / std::sqrt(reference * reference)
+              << "}" << std::endl;
+
+    // all done
+    return;
+}
+
+template <typename T>
+auto
+scalarField()
+{
+    return mito::ScalarField<2, T>(
+        [](const vector_t<2, T> & x) { return std::cos(x[0] * x[1]) * std::exp(x[0]); });
+}
+
+template <typename T>
+auto
+vectorField()
+{
+    return mito::VectorField<2, 3, T>([](const vector_t<2, T> & x) {
+        return vector_t<3, T> { std::sin(x[0]), x[0] * x[1], std::sqrt(T(1) + x[1]) };
+    });
+}
+
+int
+main()
+{
+    constexpr int n = 300;
+    mito::benchmark::StructuredMesh mesh(n);
+    mito::ElementSet elementSet(mesh.elements(), mesh.coordinatesMap());
+    integrator_t<double> integratorDouble(elementSet);
+    integrator_t<float> integratorMixed(elementSet);
+
+    auto scalarDouble = integrate(
+        "mixed-precision/scalar/double", integratorDouble, scalarField<double>(),
+        elementSet.nElements());
+    auto scalarMixed = integrate(
+        "mixed-precision/scalar/mixed", integratorMixed, scalarField<float>(),
+        elementSet.nElements());
+    error("mixed-precision/scalar", vector_t<1>(scalarMixed), vector_t<1>(scalarDouble));
+
+    auto vectorDouble = integrate(
+        "mixed-precision/vector/double", integratorDouble, vectorField<double>(),
+        elementSet.nElements());
+    auto vectorMixed = integrate(
+        "mixed-precision/vector/mixed", integratorMixed, vectorField<float>(),
+        elementSet.nElements());
+    error("mixed-precision/vector", vectorMixed, vectorDouble);
+
+    // all done
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,46 @@
+#include <cmath>
+#include <thread>
+#include "../benchmark.h"
+#include "../../math/Field.h"
+#include "../../parallel/ThreadPool.h"
+
+using mito::vector_t;
+using mito::real;
+
+// scaling of the evaluation of a field on the points of a quadrature field, from 1 thread to the
+// number of hardware threads
+
+int
+main()
+{
+    constexpr int Q = 3;
+    constexpr int nElements = 1000000;
+    mito::quadrature_field_t<Q, vector_t<2>> points(nElements);
+    for (int e = 0; e < nElements; ++e) {
+        for (int q = 0; q < Q; ++q) {
+            points(e, q) = vector_t<2> { real(e) / nElements, real(q) / Q };
+        }
+    }
+
+    // a field with some work per point
+    mito::ScalarField<2> field(mito::Function<vector_t<2>>([](const vector_t<2> & x) {
+        return cos(x[0] * x[1]) * exp(-x[0]) + sqrt(1.0 + x[1] * x[1]);
+    }));
+
+    mito::benchmark::run(
+        "parallel-fields/serial", 10, [&]() { mito::benchmark::doNotOptimize(field(points)); },
+        nElements * Q);
+
+    int N = std::max(1, int(std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= N; threads = threads < N ? std::min(2 * threads, N) : N + 1) {
+        mito::ThreadPool pool(threads);
+        mito::benchmark::run(
+            "parallel-fields/threads-" + std::to_string(threads), 10,
+            [&]() { mito::benchmark::doNotOptimize(field(points, pool)); }, nElements * Q);
+    }
+
+    // all done
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,104 @@
+#include "../benchmark.h"
+#include "../../mito.h"
+#include "../../algebra/SymmetricTensor.h"
+#include "../../algebra/DiagonalTensor.h"
+
+using mito::vector_t;
+using mito::tensor_t;
+using mito::sym_tensor_t;
+using mito::real;
+
+// kernels on arrays of symmetric tensors, stored packed (sym_tensor_t) and in full (tensor_t): the
+// packed storage moves 6 instead of 9 values per tensor in 3D and its kernels skip the redundant
+// entries
+
+template <class A, class F>
+void
+run(const std::string & name, int n, const std::vector<A> & tensors, F && kernel)
+{
+    std::vector<real> result(n);
+    mito::benchmark::run(
+        name, 100,
+        [&]() {
+            for (int k = 0; k < n; ++k) {
+                result[k] = kernel(tensors[k]);
+            }
+            mito::benchmark::doNotOptimize(result.data());
+        },
+        n);
+
+    // all done
+    return;
+}
+
+template <int D>
+void
+compare(const std::string & name, int n)
+{
+    std::vector<sym_tensor_t<D>> packed(n);
+    std::vector<tensor_t<D>> full(n);
+    for (int k = 0; k < n; ++k) {
+        for (int i = 0; i < D; ++i) {
+            for (int j = i; j < D; ++j) {
+                packed[k](i, j) = i == j ? D + 0.001 * k : 1.0 / (1 + i + j);
+            }
+        }
+        full[k] = packed[k];
+    }
+    vector_t<D> x;
+    for (int i = 0; i < D; ++i) {
+        x[i] = 1.0 + i;
+    }
+
+    run(name + "/determinant/packed", n, packed,
+        [](const sym_tensor_t<D> & A) { return mito::ComputeDeterminant(A); });
+    run(name + "/determinant/full", n, full,
+        [](const tensor_t<D> & A) { return mito::ComputeDeterminant(A); });
+
+    run(name + "/inverse/packed", n, packed, [](const sym_tensor_t<D> & A) {
+        sym_tensor_t<D> invA;
+        mito::ComputeInverse(A, invA);
+        return invA[0];
+    });
+    run(name + "/inverse/full", n, full, [](const tensor_t<D> & A) {
+        tensor_t<D> invA;
+        mito::ComputeInverse(A, invA);
+        return invA[0];
+    });
+
+    run(name + "/ddot/packed", n, packed,
+        [](const sym_tensor_t<D> & A) { return mito::ddot(A, A); });
+    run(name + "/ddot/full", n, full, [](const tensor_t<D> & A) {
+        real AA = 0.0;
+        for (int k = 0; k < D * D; ++k) {
+            AA += A[k] * A[k];
+        }
+        return AA;
+    });
+
+    run(name + "/matvec/packed", n, packed, [&x](const sym_tensor_t<D> & A) {
+        vector_t<D> y = A * x;
+        return y * y;
+    });
+    run(name + "/matvec/full", n, full, [&x](const tensor_t<D> & A) {
+        vector_t<D> y = A * x;
+        return y * y;
+    });
+
+    // all done
+    return;
+}
+
+int
+main()
+{
+    // in cache and streaming from memory
+    compare<2>("structured-tensors/2", 10000);
+    compare<3>("structured-tensors/3", 10000);
+    compare<3>("structured-tensors/3-streaming", 1000000);
+
+    // all done
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,83 @@
+// code guard
+#if !defined(mito_benchmarks_structured_mesh_h)
+#define mito_benchmarks_structured_mesh_h
+
+#include <deque>
+#include <vector>
+#include "../mesh/Simplex.h"
+#include "../mesh/VertexPointMap.h"
+
+namespace mito { namespace benchmark {
+
+    /**
+     * A structured triangulation of the unit square with n x n cells, each cut in two triangles
+     *   along its diagonal. Entities live in deques so that their addresses stay stable while the
+     *   mesh is being built.
+     */
+    class StructuredMesh {
+
+      public:
+        StructuredMesh(int n) : _vertices(), _segments(), _triangles(), _elements()
+        {
+            // instantiate the (n + 1) x (n + 1) vertices
+            for (int j = 0; j <= n; ++j) {
+                for (int i = 0; i <= n; ++i) {
+                    _coordinatesMap.insert(
+                        _vertices.emplace_back(), point_t<2> { real(i) / n, real(j) / n });
+                }
+            }
+
+            // instantiate two triangles per cell
+            _elements.reserve(2 * n * n);
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < n; ++i) {
+                    vertex_t * v0 = &_vertices[j * (n + 1) + i];
+                    vertex_t * v1 = &_vertices[j * (n + 1) + i + 1];
+                    vertex_t * v2 = &_vertices[(j + 1) * (n + 1) + i + 1];
+                    vertex_t * v3 = &_vertices[(j + 1) * (n + 1) + i];
+                    _addTriangle(v0, v1, v2);
+                    _addTriangle(v0, v2, v3);
+                }
+            }
+
+            // all done
+            return;
+        }
+
+      private:
+        // delete copy constructor
+        StructuredMesh(const StructuredMesh &) = delete;
+
+        // delete assignment operator
+        const StructuredMesh & operator=(const StructuredMesh &) = delete;
+
+      public:
+        inline const std::vector<triangle_t *> & elements() const { return _elements; }
+        inline const VertexPointMap<2> & coordinatesMap() const { return _coordinatesMap; }
+
+      private:
+        void _addTriangle(vertex_t * v0, vertex_t * v1, vertex_t * v2)
+        {
+            // edges are not shared among triangles: integration only needs the vertices
+            segment_t * s0 = &_segments.emplace_back(std::array<vertex_t *, 2> { v0, v1 });
+            segment_t * s1 = &_segments.emplace_back(std::array<vertex_t *, 2> { v1, v2 });
+            segment_t * s2 = &_segments.emplace_back(std::array<vertex_t *, 2> { v2, v0 });
+            _elements.push_back(&_triangles.emplace_back(std::array<segment_t *, 3> { s0, s1, s2 }));
+
+            // all done
+            return;
+        }
+
+      private:
+        std::deque<vertex_t> _vertices;
+        std::deque<segment_t> _segments;
+        std::deque<triangle_t> _triangles;
+        std::vector<triangle_t *> _elements;
+        VertexPointMap<2> _coordinatesMap;
+    };
+
+}}    // namespace mito::benchmark
+
+#endif    // mito_benchmarks_structured_mesh_h
+
+// end of file
@@ -0,0 +1,84 @@
+#include "../benchmark.h"
+#include "../../mito.h"
+#include "../../algebra/TensorBatch.h"
+
+using mito::real;
+
+// the number of tensors in a batch
+static constexpr int N = 64;
+
+// inverse and determinant of many 3x3 tensors, one tensor at a time (array of structures) and one
+// SIMD pack at a time (arrays of batches of tensors)
+void
+inverse(const std::string & name, int nBatches, int ops)
+{
+    // the total number of tensors
+    const int n = N * nBatches;
+
+    // the same tensors as an array of structures and as arrays of batches
+    std::vector<mito::tensor_t<3>> A(n), invA(n);
+    std::vector<real> det(n);
+    std::vector<mito::TensorBatch<3, 3, N>> batchA(nBatches), batchInvA(nBatches);
+    std::vector<mito::ScalarBatch<N>> batchDet(nBatches);
+    for (int i = 0; i < n; ++i) {
+        A[i] = mito::tensor_t<3> { 4.0 + i % 7, 1.0, 0.0, 1.0, 3.0, 0.5, 0.0, 0.5, 2.0 };
+        batchA[i / N].set(i % N, A[i]);
+    }
+
+    mito::benchmark::run(
+        name + "/inverse-3/per-tensor", ops,
+        [&]() {
+            for (int i = 0; i < n; ++i) {
+                det[i] = mito::ComputeInverse(A[i], invA[i]);
+            }
+            mito::benchmark::doNotOptimize(invA.data());
+        },
+        n);
+
+    mito::benchmark::run(
+        name + "/inverse-3/batched", ops,
+        [&]() {
+            for (int b = 0; b < nBatches; ++b) {
+                mito::ComputeInverse(batchA[b], batchInvA[b], batchDet[b]);
+            }
+            mito::benchmark::doNotOptimize(batchInvA.data());
+        },
+        n);
+
+    mito::benchmark::run(
+        name + "/determinant-3/per-tensor", ops,
+        [&]() {
+            for (int i = 0; i < n; ++i) {
+                det[i] = mito::ComputeDeterminant(A[i]);
+            }
+            mito::benchmark::doNotOptimize(det.data());
+        },
+        n);
+
+    mito::benchmark::run(
+        name + "/determinant-3/batched", ops,
+        [&]() {
+            for (int b = 0; b < nBatches; ++b) {
+                mito::ComputeDeterminant(batchA[b], batchDet[b]);
+            }
+            mito::benchmark::doNotOptimize(batchDet.data());
+        },
+        n);
+
+    // all done
+    return;
+}
+
+int
+main()
+{
+    // working set in cache: the kernels are compute bound
+    inverse("tensor-batch/in-cache", 64, 2000);
+    // working set in main memory: the kernels are bandwidth bound
+    inverse("tensor-batch/streaming", 4096, 20);
+
+    // all done
+    return 0;
+}
+
+// end of file
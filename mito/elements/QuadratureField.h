@@ -34,7 +34,7 @@ namespace mito {
         {}
 
       private:
-        inline QuadratureField(int nElements, const pack_t & packing) :
+        inline QuadratureField(int /*nElements*/, const pack_t & packing) :
             _grid { packing, packing.cells() }
         {
             // initialize memory
@@ -85,6 +85,18 @@ namespace mito {
             return _grid[index];
         }
 
+        /**
+         * accessor to the data of all quadrature points, stored contiguously element by element
+         * @return pointer to the data at quadrature point {0} of element {0}
+         */
+        inline Y * data() { return &_grid[{ 0, 0 }]; }
+
+        /**
+         * accessor to the data of all quadrature points, stored contiguously element by element
+         * @return pointer to the data at quadrature point {0} of element {0}
+         */
+        inline const Y * data() const { return &_grid[{ 0, 0 }]; }
+
         /**
          * accessor for the size of array stored per quadrature point per element
          * @return the size of array stored per quadrature point per element
@@ -1,6 +1,7 @@
 #if !defined(mito_materials_Gent_h)
 #define mito_materials_Gent_h
 
+#include <cmath>
 #include "../mito.h"
 
 namespace mito {
@@ -25,7 +26,7 @@ namespace mito {
     };
 
     template <int D /*dim*/>
-    void Gent::Constitutive(const vector_t<D> & u, const tensor_t<D> & Du, tensor_t<D> & P)
+    void Gent::Constitutive(const vector_t<D> & /*u*/, const tensor_t<D> & Du, tensor_t<D> & P)
     {
         // deformation gradient
         tensor_t<D> F = Du;
@@ -40,14 +41,9 @@ namespace mito {
         // J^2 - 1
         real Jsq_minus_1 = detF * detF - 1.;
         // log(J)
-        real logJ = log(detF);
-        // tr(C)
-        real trC = 0.0;
-        for (int i = 0; i < D; i++) {
-            for (int J = 0; J < D; J++) {
-                trC += F[i * D + J] * F[i * D + J];
-            }
-        }
+        real logJ = std::log(detF);
+        // tr(C) = F:F
+        real trC = ddot(F, F);
         // (J^2 -1)/2 - log(J)
         real A = 0.5 * Jsq_minus_1 - logJ;
         // Jm - trC + D /*dim*/
@@ -55,13 +51,8 @@ namespace mito {
         // Jm / (Jm - trC + D /*dim*/))
         real B = _Jm / C;
 
-        // fill the first Piola stress tensor
-        for (int i = 0; i < D; i++) {
-            for (int J = 0; J < D; J++) {
-                P[i * D + J] = _mu * B * F[i * D + J]
-                             + (2. * _kappa * A * A * A * Jsq_minus_1 - _mu) * invF[J * D + i];
-            }
-        }
+        // the first Piola stress tensor
+        P = _mu * B * F + (2. * _kappa * A * A * A * Jsq_minus_1 - _mu) * transpose(invF);
 
         return;
     }
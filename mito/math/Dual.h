@@ -0,0 +1,284 @@
+// code guard
+#if !defined(mito_math_Dual_h)
+#define mito_math_Dual_h
+
+#include <cmath>
+#include <compare>
+#include "../mito.h"
+
+// Forward-mode automatic differentiation: a dual number carries a value together with its
+// gradient with respect to D independent variables, and the arithmetic and the elementary
+// functions below propagate both by the chain rule (they are found by argument dependent lookup).
+// Evaluating a function written generically in its scalar type (e.g. a generic lambda using
+// unqualified {cos}, {exp}, ...) on the point returned by {seed} yields its value and all of its
+// D partial derivatives in a single pass.
+
+namespace mito {
+
+    template <int D, typename T = real>
+    class Dual {
+
+      public:
+        // the number of entries (a dual number is a scalar)
+        static constexpr int S = 1;
+        // the underlying type (a dual number is its own scalar type)
+        using type = Dual;
+        // the type of the gradient
+        using gradient_type = vector_t<D, T>;
+
+      public:
+        // default constructor (zero value and gradient)
+        constexpr Dual() : _value(), _gradient() {}
+
+        // constructor from a constant (zero gradient)
+        constexpr Dual(const T & value) : _value(value), _gradient() {}
+
+        // constructor from value and gradient
+        constexpr Dual(const T & value, const gradient_type & gradient) :
+            _value(value),
+            _gradient(gradient)
+        {}
+
+      public:
+        // accessor for the value
+        constexpr const T & value() const { return _value; }
+
+        // accessor for the gradient
+        constexpr const gradient_type & gradient() const { return _gradient; }
+
+        constexpr Dual & operator+=(const Dual & rhs)
+        {
+            _value += rhs._value;
+            _gradient += rhs._gradient;
+
+            // all done
+            return *this;
+        }
+
+        constexpr Dual & operator-=(const Dual & rhs) { return *this = *this - rhs; }
+
+        constexpr Dual & operator*=(const Dual & rhs) { return *this = *this * rhs; }
+
+        constexpr Dual & operator/=(const Dual & rhs) { return *this = *this / rhs; }
+
+      private:
+        // the value
+        T _value;
+        // the partial derivatives of the value
+        gradient_type _gradient;
+    };
+
+    // helper function: the unit vector along axis {i}
+    template <int D, typename T>
+    constexpr auto _unit(int i)
+    {
+        vector_t<D, T> e;
+        e[i] = T(1);
+        return e;
+    }
+
+    // helper function: seed each coordinate of {x} with its direction
+    template <int D, typename T, size_t... I>
+    constexpr auto _seed(const vector_t<D, T> & x, std::index_sequence<I...>)
+    {
+        return vector_t<D, Dual<D, T>> { Dual<D, T>(x[I], _unit<D, T>(I))... };
+    }
+
+    // the point {x} as a vector of dual numbers, seeded with the directions of the coordinate axes
+    template <int D, typename T>
+    constexpr auto seed(const vector_t<D, T> & x)
+    {
+        return _seed(x, std::make_index_sequence<D> {});
+    }
+
+    // Arithmetic operations on dual numbers
+    // a + b
+    template <int D, typename T>
+    constexpr auto operator+(const Dual<D, T> & a, const Dual<D, T> & b)
+    {
+        return Dual<D, T>(a.value() + b.value(), a.gradient() + b.gradient());
+    }
+
+    // -a
+    template <int D, typename T>
+    constexpr auto operator-(const Dual<D, T> & a)
+    {
+        return Dual<D, T>(-a.value(), -a.gradient());
+    }
+
+    // a - b
+    template <int D, typename T>
+    constexpr auto operator-(const Dual<D, T> & a, const Dual<D, T> & b)
+    {
+        return Dual<D, T>(a.value() - b.value(), a.gradient() - b.gradient());
+    }
+
+    // a * b
+    template <int D, typename T>
+    constexpr auto operator*(const Dual<D, T> & a, const Dual<D, T> & b)
+    {
+        return Dual<D, T>(
+            a.value() * b.value(), b.value() * a.gradient() + a.value() * b.gradient());
+    }
+
+    // a / b
+    template <int D, typename T>
+    constexpr auto operator/(const Dual<D, T> & a, const Dual<D, T> & b)
+    {
+        T q = a.value() / b.value();
+        return Dual<D, T>(q, (a.gradient() - q * b.gradient()) / b.value());
+    }
+
+    // a + c, c + a
+    template <int D, typename T>
+    constexpr auto operator+(const Dual<D, T> & a, const std::type_identity_t<T> & c)
+    {
+        return Dual<D, T>(a.value() + c, a.gradient());
+    }
+    template <int D, typename T>
+    constexpr auto operator+(const std::type_identity_t<T> & c, const Dual<D, T> & a)
+    {
+        return a + c;
+    }
+
+    // a - c, c - a
+    template <int D, typename T>
+    constexpr auto operator-(const Dual<D, T> & a, const std::type_identity_t<T> & c)
+    {
+        return Dual<D, T>(a.value() - c, a.gradient());
+    }
+    template <int D, typename T>
+    constexpr auto operator-(const std::type_identity_t<T> & c, const Dual<D, T> & a)
+    {
+        return Dual<D, T>(c - a.value(), -a.gradient());
+    }
+
+    // a * c, c * a
+    template <int D, typename T>
+    constexpr auto operator*(const std::type_identity_t<T> & c, const Dual<D, T> & a)
+    {
+        return Dual<D, T>(c * a.value(), c * a.gradient());
+    }
+    template <int D, typename T>
+    constexpr auto operator*(const Dual<D, T> & a, const std::type_identity_t<T> & c)
+    {
+        return c * a;
+    }
+
+    // a / c, c / a
+    template <int D, typename T>
+    constexpr auto operator/(const Dual<D, T> & a, const std::type_identity_t<T> & c)
+    {
+        return Dual<D, T>(a.value() / c, a.gradient() / c);
+    }
+    template <int D, typename T>
+    constexpr auto operator/(const std::type_identity_t<T> & c, const Dual<D, T> & a)
+    {
+        T q = c / a.value();
+        return Dual<D, T>(q, (-q / a.value()) * a.gradient());
+    }
+
+    // comparisons (on the values; {!=}, and the comparisons with the number first, follow from
+    // these)
+    template <int D, typename T>
+    constexpr bool operator==(const Dual<D, T> & a, const Dual<D, T> & b)
+    {
+        return a.value() == b.value();
+    }
+    template <int D, typename T>
+    constexpr bool operator==(const Dual<D, T> & a, const std::type_identity_t<T> & c)
+    {
+        return a.value() == c;
+    }
+    template <int D, typename T>
+    constexpr auto operator<=>(const Dual<D, T> & a, const Dual<D, T> & b)
+    {
+        return a.value() <=> b.value();
+    }
+    template <int D, typename T>
+    constexpr auto operator<=>(const Dual<D, T> & a, const std::type_identity_t<T> & c)
+    {
+        return a.value() <=> c;
+    }
+
+    // helper function: the dual number of f(a), given f(a) and f'(a)
+    template <int D, typename T>
+    constexpr auto _chain(const Dual<D, T> & a, const T & f, const T & df)
+    {
+        return Dual<D, T>(f, df * a.gradient());
+    }
+
+    // Elementary functions of dual numbers
+    template <int D, typename T>
+    inline auto sin(const Dual<D, T> & a)
+    {
+        return _chain(a, std::sin(a.value()), std::cos(a.value()));
+    }
+
+    template <int D, typename T>
+    inline auto cos(const Dual<D, T> & a)
+    {
+        return _chain(a, std::cos(a.value()), -std::sin(a.value()));
+    }
+
+    template <int D, typename T>
+    inline auto tan(const Dual<D, T> & a)
+    {
+        T f = std::tan(a.value());
+        return _chain(a, f, T(1) + f * f);
+    }
+
+    template <int D, typename T>
+    inline auto atan(const Dual<D, T> & a)
+    {
+        return _chain(a, std::atan(a.value()), T(1) / (T(1) + a.value() * a.value()));
+    }
+
+    template <int D, typename T>
+    inline auto exp(const Dual<D, T> & a)
+    {
+        T f = std::exp(a.value());
+        return _chain(a, f, f);
+    }
+
+    template <int D, typename T>
+    inline auto log(const Dual<D, T> & a)
+    {
+        return _chain(a, std::log(a.value()), T(1) / a.value());
+    }
+
+    template <int D, typename T>
+    inline auto sqrt(const Dual<D, T> & a)
+    {
+        T f = std::sqrt(a.value());
+        return _chain(a, f, T(0.5) / f);
+    }
+
+    template <int D, typename T>
+    inline auto pow(const Dual<D, T> & a, const std::type_identity_t<T> & p)
+    {
+        return _chain(a, std::pow(a.value(), p), p * std::pow(a.value(), p - T(1)));
+    }
+
+    template <int D, typename T>
+    inline auto fabs(const Dual<D, T> & a)
+    {
+        return a.value() < T(0) ? -a : a;
+    }
+
+    template <int D, typename T>
+    std::ostream & operator<<(std::ostream & os, const Dual<D, T> & a)
+    {
+        return os << a.value() << " + " << a.gradient() << " eps";
+    }
+
+    // tag requesting the partial derivatives of a field by automatic differentiation, i.e. by
+    // evaluating the function it is built from on dual numbers
+    struct autodiff_t {};
+    inline constexpr autodiff_t autodiff {};
+
+}    // namespace mito
+
+#endif    // mito_math_Dual_h
+
+// end of file
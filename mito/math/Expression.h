@@ -0,0 +1,748 @@
+// code guard
+#if !defined(mito_math_Expression_h)
+#define mito_math_Expression_h
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <numbers>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "../mito.h"
+#include "Function.h"
+
+// Expressions compiled at runtime, e.g. for the fields given as strings in the input files:
+//
+//      sin(x[0]) * t                       a scalar expression of the coordinates and of time
+//      [0, -9.81 * x1, 0]                  a vector expression (components separated by commas)
+//      [0 -1*t x[2]]                       ... or by white spaces (then, as in MATLAB, {-1} with no
+//                                          space after the sign starts a new component)
+//
+// The coordinates are {x[i]} (or {xi}), time is {t}, and {pi} is a constant. The operators are
+// {+ - * / ^} and the functions are {sin, cos, tan, atan, exp, log, sqrt, abs, pow}.
+//
+// The expression is parsed once into a graph in which equal subexpressions are shared (common
+// subexpression elimination) and operations on constants are folded (as are the operations with
+// neutral elements that give the same result for all reals, e.g. {x * 1}, but not {x * 0}, which
+// is not 0 if x is infinite or NaN). The graph is then compiled
+// into a program of instructions on registers, each holding the values of an operand at a batch
+// of points, so that evaluating an instruction is a tight (vectorizable) loop over the batch.
+
+namespace mito {
+
+    class Expression {
+
+      public:
+        // the operations of the expression graph (and the instructions of the compiled program)
+        enum class Op {
+            CONSTANT,
+            VARIABLE,
+            ADD,
+            SUB,
+            MUL,
+            DIV,
+            POW,
+            NEG,
+            SIN,
+            COS,
+            TAN,
+            ATAN,
+            EXP,
+            LOG,
+            SQRT,
+            ABS
+        };
+
+      private:
+        // a node of the expression graph: an operation on (up to) two other nodes, a constant, or
+        // a variable (a coordinate, or time)
+        struct Node {
+            Op op;
+            int a;
+            int b;
+            real value;
+            int variable;
+        };
+
+        // an instruction of the compiled program: {result = op(a, b)} on registers
+        struct Instruction {
+            Op op;
+            int result;
+            int a;
+            int b;
+        };
+
+      public:
+        /**
+         * constructor
+         * @param[in] text the expression
+         * @param[in] D the number of coordinates
+         */
+        inline Expression(const std::string & text, int D) :
+            _text(text),
+            _position(0),
+            _D(D),
+            _valid(true),
+            _message(),
+            _nodes(),
+            _table(),
+            _roots(),
+            _program(),
+            _constants(),
+            _variables(),
+            _outputs(),
+            _registers(0)
+        {
+            // parse the expression
+            _parse();
+
+            // compile the expression
+            if (_valid) {
+                _compile();
+            }
+
+            // all done
+            return;
+        }
+
+      public:
+        // whether the expression was parsed successfully
+        inline bool valid() const { return _valid; }
+
+        // the description of the error in the expression (empty if it is valid)
+        inline const std::string & message() const { return _message; }
+
+        // the number of components of the expression
+        inline int components() const { return _outputs.size(); }
+
+        // the number of instructions of the compiled program
+        inline int instructions() const { return _program.size(); }
+
+        // the number of nodes of the expression graph
+        inline int nodes() const { return _nodes.size(); }
+
+        // whether the value of the expression depends on time
+        inline bool timeDependent() const
+        {
+            return std::ranges::any_of(
+                _variables, [this](const auto & variable) { return variable.second == _D; });
+        }
+
+        /**
+         * evaluate the expression at {n} points
+         * @param[in] x the coordinates of the points (D per point)
+         * @param[in] t the time
+         * @param[out] y the values of the expression (components() per point)
+         * @param[in] n the number of points
+         */
+        inline void operator()(const real * x, real t, real * y, int n) const
+        {
+            // the number of points in a batch (fewer if there are fewer points, e.g. when evaluating
+            // at one point at a time)
+            const int lanes = std::min(n, batch_size);
+
+            // the registers, each holding the values of an operand at a batch of points (kept by
+            // each thread from one evaluation to the next, so that evaluating does not allocate)
+            thread_local std::vector<real> scratch;
+            scratch.resize(_registers * lanes);
+            real * registers = scratch.data();
+
+            // constants and time are the same at all points
+            for (const auto & [r, value] : _constants) {
+                std::fill_n(registers + r * lanes, lanes, value);
+            }
+            for (const auto & [r, i] : _variables) {
+                if (i == _D) {
+                    std::fill_n(registers + r * lanes, lanes, t);
+                }
+            }
+
+            for (int b = 0; b < n; b += lanes) {
+                int m = std::min(lanes, n - b);
+
+                // load the coordinates
+                for (const auto & [r, i] : _variables) {
+                    if (i < _D) {
+                        real * v = registers + r * lanes;
+                        for (int k = 0; k < m; ++k) {
+                            v[k] = x[(b + k) * _D + i];
+                        }
+                    }
+                }
+
+                // run the program
+                for (const auto & instruction : _program) {
+                    _execute(instruction, registers, lanes, m);
+                }
+
+                // store the components
+                int C = components();
+                for (int c = 0; c < C; ++c) {
+                    const real * v = registers + _outputs[c] * lanes;
+                    for (int k = 0; k < m; ++k) {
+                        y[(b + k) * C + c] = v[k];
+                    }
+                }
+            }
+
+            // all done
+            return;
+        }
+
+      private:
+        // helper function: apply {op} to the scalars {a} and {b}
+        static inline real _apply(Op op, real a, real b)
+        {
+            switch (op) {
+                case Op::ADD:
+                    return a + b;
+                case Op::SUB:
+                    return a - b;
+                case Op::MUL:
+                    return a * b;
+                case Op::DIV:
+                    return a / b;
+                case Op::POW:
+                    return std::pow(a, b);
+                case Op::NEG:
+                    return -a;
+                case Op::SIN:
+                    return std::sin(a);
+                case Op::COS:
+                    return std::cos(a);
+                case Op::TAN:
+                    return std::tan(a);
+                case Op::ATAN:
+                    return std::atan(a);
+                case Op::EXP:
+                    return std::exp(a);
+                case Op::LOG:
+                    return std::log(a);
+                case Op::SQRT:
+                    return std::sqrt(a);
+                case Op::ABS:
+                    return std::fabs(a);
+                default:
+                    assert(false);
+                    return 0.0;
+            }
+        }
+
+        // helper function: {r[k] = f(a[k])} for the {m} points of a batch
+        template <class F>
+        static inline void _unary(real * r, const real * a, int m, F f)
+        {
+            for (int k = 0; k < m; ++k) {
+                r[k] = f(a[k]);
+            }
+        }
+
+        // helper function: {r[k] = f(a[k], b[k])} for the {m} points of a batch
+        template <class F>
+        static inline void _binary(real * r, const real * a, const real * b, int m, F f)
+        {
+            for (int k = 0; k < m; ++k) {
+                r[k] = f(a[k], b[k]);
+            }
+        }
+
+        // helper function: execute {instruction} on the {m} points of a batch (on registers of
+        // {lanes} values each)
+        static inline void _execute(
+            const Instruction & instruction, real * registers, int lanes, int m)
+        {
+            real * r = registers + instruction.result * lanes;
+            const real * a = registers + instruction.a * lanes;
+            const real * b = registers + instruction.b * lanes;
+
+            switch (instruction.op) {
+                case Op::ADD:
+                    return _binary(r, a, b, m, [](real a, real b) { return a + b; });
+                case Op::SUB:
+                    return _binary(r, a, b, m, [](real a, real b) { return a - b; });
+                case Op::MUL:
+                    return _binary(r, a, b, m, [](real a, real b) { return a * b; });
+                case Op::DIV:
+                    return _binary(r, a, b, m, [](real a, real b) { return a / b; });
+                case Op::POW:
+                    return _binary(r, a, b, m, [](real a, real b) { return std::pow(a, b); });
+                case Op::NEG:
+                    return _unary(r, a, m, [](real a) { return -a; });
+                case Op::SIN:
+                    return _unary(r, a, m, [](real a) { return std::sin(a); });
+                case Op::COS:
+                    return _unary(r, a, m, [](real a) { return std::cos(a); });
+                case Op::TAN:
+                    return _unary(r, a, m, [](real a) { return std::tan(a); });
+                case Op::ATAN:
+                    return _unary(r, a, m, [](real a) { return std::atan(a); });
+                case Op::EXP:
+                    return _unary(r, a, m, [](real a) { return std::exp(a); });
+                case Op::LOG:
+                    return _unary(r, a, m, [](real a) { return std::log(a); });
+                case Op::SQRT:
+                    return _unary(r, a, m, [](real a) { return std::sqrt(a); });
+                case Op::ABS:
+                    return _unary(r, a, m, [](real a) { return std::fabs(a); });
+                default:
+                    assert(false);
+                    return;
+            }
+        }
+
+      private:
+        // helper function: the node for {key}, added to the graph if it is not there yet
+        inline int _insert(const Node & node)
+        {
+            // the key identifying the node (the bits of the value, so that e.g. 0 and -0 differ)
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &node.value, sizeof(real));
+            auto key = std::make_tuple(int(node.op), node.a, node.b, bits, node.variable);
+
+            // if an equal node is already in the graph, share it
+            auto found = _table.find(key);
+            if (found != _table.end()) {
+                return found->second;
+            }
+
+            // otherwise, add it
+            _nodes.push_back(node);
+            _table[key] = _nodes.size() - 1;
+            return _nodes.size() - 1;
+        }
+
+        // helper function: the node of the constant {value}
+        inline int _constant(real value) { return _insert({ Op::CONSTANT, -1, -1, value, -1 }); }
+
+        // helper function: the node of variable {i} (coordinate {i}, or time if {i == D})
+        inline int _variable(int i) { return _insert({ Op::VARIABLE, -1, -1, 0.0, i }); }
+
+        // helper function: whether node {i} is the constant {value} (with its sign, if 0)
+        inline bool _is(int i, real value) const
+        {
+            return _nodes[i].op == Op::CONSTANT && _nodes[i].value == value
+                && std::signbit(_nodes[i].value) == std::signbit(value);
+        }
+
+        // helper function: the node of {op(a, b)}, simplified
+        inline int _node(Op op, int a, int b = -1)
+        {
+            // fold operations on constants
+            if (_nodes[a].op == Op::CONSTANT && (b < 0 || _nodes[b].op == Op::CONSTANT)) {
+                return _constant(_apply(op, _nodes[a].value, b < 0 ? 0.0 : _nodes[b].value));
+            }
+
+            // simplify the operations with neutral elements that are exact for all reals (unlike
+            // e.g. {x + 0}, which is 0 and not -0 for x = -0, or {x ^ 0.5}, which is +inf and not
+            // NaN for x = -inf)
+            if (op == Op::MUL && _is(a, 1.0)) {
+                return b;
+            }
+            if ((op == Op::SUB && _is(b, 0.0))
+                || ((op == Op::MUL || op == Op::DIV || op == Op::POW) && _is(b, 1.0))) {
+                return a;
+            }
+            if (op == Op::POW && _is(b, 2.0)) {
+                return _node(Op::MUL, a, a);
+            }
+
+            // order the operands of commutative operations, so that e.g. {a * b} and {b * a} are
+            // the same node
+            if ((op == Op::ADD || op == Op::MUL) && a > b) {
+                std::swap(a, b);
+            }
+
+            // all done
+            return _insert({ op, a, b, 0.0, -1 });
+        }
+
+      private:
+        // helper function: report a parse error
+        inline int _error(const std::string & message)
+        {
+            // record only the first error
+            if (_valid) {
+                _message = message + " at position " + std::to_string(_position)
+                         + " in expression \"" + _text + "\"";
+            }
+            _valid = false;
+
+            // move to the end of the text
+            _position = _text.size();
+
+            // all done
+            return _constant(0.0);
+        }
+
+        // helper function: skip white spaces and return whether there were any
+        inline bool _skip()
+        {
+            int start = _position;
+            while (_position < (int) _text.size() && std::isspace(_text[_position])) {
+                ++_position;
+            }
+            return _position > start;
+        }
+
+        // helper function: the next character (or '\0' at the end of the text)
+        inline char _peek() const
+        {
+            return _position < (int) _text.size() ? _text[_position] : '\0';
+        }
+
+        // helper function: whether the next character can start an operand
+        inline bool _operand() const
+        {
+            char c = _peek();
+            return std::isalnum(c) || c == '.' || c == '(' || c == '_' || c == '-' || c == '+';
+        }
+
+        // parse: expression | '[' expression ((',')? expression)* ']'
+        inline void _parse()
+        {
+            _skip();
+
+            // a vector expression
+            if (_peek() == '[') {
+                ++_position;
+                _skip();
+                while (_valid && _peek() != ']') {
+                    _roots.push_back(_expression(true));
+                    _skip();
+                    if (_peek() == ',') {
+                        ++_position;
+                    } else if (_peek() != ']' && !_operand()) {
+                        _error("expected ',' or ']'");
+                    }
+                }
+                ++_position;
+            }
+            // a scalar expression
+            else {
+                _roots.push_back(_expression(false));
+            }
+
+            // make sure there is nothing left
+            _skip();
+            if (_valid && _position < (int) _text.size()) {
+                _error("unexpected character");
+            }
+
+            // all done
+            return;
+        }
+
+        // parse: term (('+' | '-') term)*
+        // (in a list, a sign preceded but not followed by a space starts a new component)
+        inline int _expression(bool list)
+        {
+            int node = _term();
+            while (_valid) {
+                int start = _position;
+                bool space = _skip();
+                char c = _peek();
+                if (c != '+' && c != '-') {
+                    _position = start;
+                    break;
+                }
+                if (list && space && _position + 1 < (int) _text.size()
+                    && !std::isspace(_text[_position + 1])) {
+                    _position = start;
+                    break;
+                }
+                ++_position;
+                node = _node(c == '+' ? Op::ADD : Op::SUB, node, _term());
+            }
+            return node;
+        }
+
+        // parse: unary (('*' | '/') unary)*
+        inline int _term()
+        {
+            int node = _unary();
+            while (_valid) {
+                int start = _position;
+                _skip();
+                char c = _peek();
+                if (c != '*' && c != '/') {
+                    _position = start;
+                    break;
+                }
+                ++_position;
+                node = _node(c == '*' ? Op::MUL : Op::DIV, node, _unary());
+            }
+            return node;
+        }
+
+        // parse: ('+' | '-') unary | power
+        inline int _unary()
+        {
+            _skip();
+            if (_peek() == '-') {
+                ++_position;
+                return _node(Op::NEG, _unary());
+            }
+            if (_peek() == '+') {
+                ++_position;
+                return _unary();
+            }
+            return _power();
+        }
+
+        // parse: primary ('^' unary)?
+        inline int _power()
+        {
+            int node = _primary();
+            int start = _position;
+            _skip();
+            if (_peek() == '^') {
+                ++_position;
+                return _node(Op::POW, node, _unary());
+            }
+            _position = start;
+            return node;
+        }
+
+        // parse: number | variable | function '(' expression (',' expression)? ')'
+        //      | '(' expression ')'
+        inline int _primary()
+        {
+            _skip();
+            char c = _peek();
+
+            // a parenthesized expression
+            if (c == '(') {
+                ++_position;
+                int node = _expression(false);
+                _skip();
+                if (_peek() != ')') {
+                    return _error("expected ')'");
+                }
+                ++_position;
+                return node;
+            }
+
+            // a number
+            if (std::isdigit(c) || c == '.') {
+                const char * start = _text.c_str() + _position;
+                char * end = nullptr;
+                real value = std::strtod(start, &end);
+                if (end == start) {
+                    return _error("expected a number");
+                }
+                _position += end - start;
+                return _constant(value);
+            }
+
+            // an identifier
+            if (!std::isalpha(c) && c != '_') {
+                return _error("expected an operand");
+            }
+            int start = _position;
+            while (std::isalnum(_peek()) || _peek() == '_') {
+                ++_position;
+            }
+            std::string name = _text.substr(start, _position - start);
+
+            // a function
+            _skip();
+            if (_peek() == '(') {
+                return _function(name);
+            }
+
+            // time and constants
+            if (name == "t") {
+                return _variable(_D);
+            }
+            if (name == "pi") {
+                return _constant(std::numbers::pi);
+            }
+
+            // a coordinate, as {x[i]} or {xi}
+            if (name[0] == 'x') {
+                int i = -1;
+                if (name.size() == 1 && _peek() == '[') {
+                    ++_position;
+                    _skip();
+                    const char * first = _text.c_str() + _position;
+                    char * end = nullptr;
+                    i = std::strtol(first, &end, 10);
+                    _position += end - first;
+                    _skip();
+                    if (end == first || _peek() != ']') {
+                        return _error("expected a coordinate index");
+                    }
+                    ++_position;
+                } else if (
+                    name.size() > 1 && name.find_first_not_of("0123456789", 1) == name.npos) {
+                    i = std::atoi(name.c_str() + 1);
+                }
+                if (i >= 0 && i < _D) {
+                    return _variable(i);
+                }
+                if (i >= _D) {
+                    return _error("coordinate " + name + " out of range");
+                }
+            }
+
+            // all done
+            return _error("unknown identifier " + name);
+        }
+
+        // parse: '(' expression (',' expression)? ')' as the arguments of function {name}
+        inline int _function(const std::string & name)
+        {
+            static const std::map<std::string, Op> functions = {
+                { "sin", Op::SIN },   { "cos", Op::COS },   { "tan", Op::TAN },
+                { "atan", Op::ATAN }, { "exp", Op::EXP },   { "log", Op::LOG },
+                { "sqrt", Op::SQRT }, { "abs", Op::ABS },   { "pow", Op::POW }
+            };
+            auto found = functions.find(name);
+            if (found == functions.end()) {
+                return _error("unknown function " + name);
+            }
+
+            // the arguments
+            ++_position;
+            int a = _expression(false);
+            int b = -1;
+            _skip();
+            if (found->second == Op::POW) {
+                if (_peek() != ',') {
+                    return _error("expected ','");
+                }
+                ++_position;
+                b = _expression(false);
+                _skip();
+            }
+            if (_peek() != ')') {
+                return _error("expected ')'");
+            }
+            ++_position;
+
+            // all done
+            return _node(found->second, a, b);
+        }
+
+      private:
+        // compile the expression graph into a program on registers
+        inline void _compile()
+        {
+            int N = _nodes.size();
+
+            // the nodes needed by the components, and the last node using each of them
+            std::vector<bool> needed(N, false);
+            std::vector<int> lastUse(N, -1);
+            for (auto root : _roots) {
+                needed[root] = true;
+                // the components are needed until the end
+                lastUse[root] = N;
+            }
+            for (int i = N - 1; i >= 0; --i) {
+                if (!needed[i]) {
+                    continue;
+                }
+                for (int child : { _nodes[i].a, _nodes[i].b }) {
+                    if (child >= 0) {
+                        needed[child] = true;
+                        lastUse[child] = std::max(lastUse[child], i);
+                    }
+                }
+            }
+
+            // assign a register to each needed node (as nodes are created after their operands,
+            // the order of the nodes is an order of evaluation), reusing the registers of the
+            // operands that are not needed anymore
+            std::vector<int> registers(N, -1);
+            std::vector<int> available;
+            for (int i = 0; i < N; ++i) {
+                if (!needed[i]) {
+                    continue;
+                }
+                const Node & node = _nodes[i];
+
+                // constants and variables have their own register
+                if (node.op == Op::CONSTANT || node.op == Op::VARIABLE) {
+                    registers[i] = _registers++;
+                    if (node.op == Op::CONSTANT) {
+                        _constants.emplace_back(registers[i], node.value);
+                    } else {
+                        _variables.emplace_back(registers[i], node.variable);
+                    }
+                    continue;
+                }
+
+                // release the registers of the operands used for the last time
+                for (int child : { node.a, node.b }) {
+                    if (child >= 0 && lastUse[child] == i && registers[child] >= 0
+                        && _nodes[child].op != Op::CONSTANT && _nodes[child].op != Op::VARIABLE) {
+                        available.push_back(registers[child]);
+                        // (an operand used twice, e.g. in {a * a}, is released once)
+                        lastUse[child] = -1;
+                    }
+                }
+
+                // the register of the result
+                if (available.empty()) {
+                    registers[i] = _registers++;
+                } else {
+                    registers[i] = available.back();
+                    available.pop_back();
+                }
+
+                // the instruction
+                _program.push_back(
+                    { node.op, registers[i], registers[node.a],
+                      node.b >= 0 ? registers[node.b] : registers[node.a] });
+            }
+
+            // the registers of the components
+            for (auto root : _roots) {
+                _outputs.push_back(registers[root]);
+            }
+
+            // all done
+            return;
+        }
+
+      private:
+        // the text of the expression
+        std::string _text;
+        // the position of the parser in the text
+        int _position;
+        // the number of coordinates
+        int _D;
+        // whether the expression was parsed successfully
+        bool _valid;
+        // the description of the first error in the expression
+        std::string _message;
+        // the nodes of the expression graph
+        std::vector<Node> _nodes;
+        // the nodes of the expression graph, by operation, operands, value and variable
+        std::map<std::tuple<int, int, int, std::uint64_t, int>, int> _table;
+        // the nodes of the components
+        std::vector<int> _roots;
+        // the compiled program
+        std::vector<Instruction> _program;
+        // the registers of the constants, with their values
+        std::vector<std::pair<int, real>> _constants;
+        // the registers of the variables, with their index (coordinate, or time if D)
+        std::vector<std::pair<int, int>> _variables;
+        // the registers of the components
+        std::vector<int> _outputs;
+        // the number of registers
+        int _registers;
+    };
+
+}    // namespace mito
+
+#endif    // mito_math_Expression_h
+
+// end of file
@@ -0,0 +1,58 @@
+// code guard
+#if !defined(mito_math_ExpressionField_h)
+#define mito_math_ExpressionField_h
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "../mito.h"
+#include "Expression.h"
+#include "TimeDependentField.h"
+
+// The fields given by expressions compiled at runtime (see Expression.h, which has no dependence
+// on the fields and can be used on its own, e.g. by the readers of input files)
+
+namespace mito {
+
+    // the field of {X} with values in {Y} given by the expression {text}, as a function of the
+    // points and of time (evaluated in batch by the compiled program of the expression); throws
+    // {std::invalid_argument} if the expression is invalid or does not have as many components as
+    // {Y}
+    template <typename X, typename Y = scalar_t<>>
+    TimeDependentField<X, Y> expression(const std::string & text)
+    {
+        // the points and the values are read and written as contiguous arrays of reals
+        static_assert(sizeof(X) == size<X>::value * sizeof(real));
+        static_assert(sizeof(Y) == size<Y>::value * sizeof(real));
+
+        // compile the expression
+        auto program = std::make_shared<const Expression>(text, size<X>::value);
+        if (!program->valid()) {
+            throw std::invalid_argument(program->message());
+        }
+        if (program->components() != size<Y>::value) {
+            throw std::invalid_argument(
+                "expression \"" + text + "\" has " + std::to_string(program->components())
+                + " components instead of " + std::to_string(size<Y>::value));
+        }
+
+        // a field constant in time, evaluated in batch
+        if (!program->timeDependent()) {
+            return TimeDependentField<X, Y>(
+                Field<X, Y>(batch_functor<X, Y>([program](const X * x, Y * y, int n) {
+                    (*program)(&x[0][0], 0.0, &y[0][0], n);
+                })));
+        }
+
+        // all done
+        return TimeDependentField<X, Y>(typename TimeDependentField<X, Y>::batch_functor_t(
+            [program](const X * x, real t, Y * y, int n) {
+                (*program)(&x[0][0], t, &y[0][0], n);
+            }));
+    }
+
+}    // namespace mito
+
+#endif    // mito_math_ExpressionField_h
+
+// end of file
@@ -2,9 +2,13 @@
 #if !defined(mito_math_Field_h)
 #define mito_math_Field_h
 
+#include <algorithm>
+#include <memory>
 #include "Function.h"
+#include "Dual.h"
 #include "../mito.h"
 #include "../elements/QuadratureField.h"
+#include "../parallel/ThreadPool.h"
 
 namespace mito {
 
@@ -20,6 +24,11 @@ namespace mito {
         // typedef for a scalar valued function
         using function_t = Function<X, Y>;
         using functor_t = functor<X, Y>;
+        using batch_functor_t = batch_functor<X, Y>;
+
+      public:
+        // typedef for a functor computing the function and all its partial derivatives at once
+        using jet_functor_t = std::function<void(const X & x, Y & y, std::array<Y, D> & Dy)>;
 
       public:
         // constructors with function_t
@@ -36,6 +45,29 @@ namespace mito {
         Field(const functor_t & f, std::array<functor_t, D> && Df) : _f(f), _Df(Df) {}
         Field(functor_t && f, std::array<functor_t, D> && Df) : _f(f), _Df(Df) {}
 
+        // constructor with batch_functor_t
+        Field(const batch_functor_t & f) : _f(f), _Df() {}
+
+        // constructor with jet_functor_t
+        Field(const jet_functor_t & jet) : Field(_value(jet), jet) {}
+
+        // constructor with a callable written generically in its scalar type, opting in with the
+        // tag {autodiff}: the partial derivatives are computed exactly by automatic
+        // differentiation, all in one pass
+        template <class F>
+        Field(autodiff_t, const F & f) :
+            Field(function_t(f), jet_functor_t([f](const X & x, Y & y, std::array<Y, D> & Dy) {
+                      _differentiate(f, x, y, Dy);
+                  }))
+        {}
+
+        // constructor with the function and the functor computing it with all its derivatives
+        Field(const function_t & f, const jet_functor_t & jet) :
+            _f(f),
+            _Df(_partials(jet, std::make_index_sequence<D> {})),
+            _jet(jet)
+        {}
+
         // default move constructor
         Field(Field &&) = default;
 
@@ -60,15 +92,18 @@ namespace mito {
             return _f(x);
         }
 
-        // TODO: Note that now this operator() is the same thing as the following but the only thing
-        // that changes is the container structure
+        // evaluate at {n} contiguous points {x} and write the {n} values in {y}
+        inline void operator()(const X * x, Y * y, int n) const
+        {
+            // evaluate _f in batch
+            return _f(x, y, n);
+        }
+
         inline auto operator()(const std::vector<X> & x) const
         {
             std::vector<Y> values(x.size());
-            // evaluate operator() at all elements of X
-            for (int i = 0; i < (int) x.size(); ++i) {
-                values[i] = operator()(x[i]);
-            }
+            // evaluate operator() at all elements of x in batch
+            operator()(x.data(), values.data(), (int) x.size());
             return values;
         }
 
@@ -77,17 +112,99 @@ namespace mito {
         {
             quadrature_field_t<Q, Y> values(x.n_elements());
 
-            // evaluate operator() at all elements of x
-            for (int e = 0; e < values.n_elements(); ++e) {
-                for (int q = 0; q < Q; ++q) {
-                    values[{ e, q }] = operator()(x[{ e, q }]);
-                }
+            // evaluate operator() at all elements of x in batch
+            if (values.n_elements() > 0) {
+                operator()(x.data(), values.data(), values.n_elements() * Q);
             }
 
             // all done
             return values;
         }
 
+        // evaluate at all elements of x in parallel on the threads of {pool} (the values do not
+        // depend on the number of threads)
+        inline auto operator()(const std::vector<X> & x, ThreadPool & pool) const
+        {
+            std::vector<Y> values(x.size());
+            const X * points = x.data();
+            Y * y = values.data();
+            pool.parallel_for(x.size(), _chunk, [&](int begin, int end) {
+                operator()(points + begin, y + begin, end - begin);
+            });
+            return values;
+        }
+
+        // evaluate at all elements of x in parallel on the threads of {pool}, in chunks of
+        // elements (the values do not depend on the number of threads)
+        template <int Q>
+        inline auto operator()(const quadrature_field_t<Q, X> & x, ThreadPool & pool) const
+        {
+            quadrature_field_t<Q, Y> values(x.n_elements());
+
+            if (values.n_elements() > 0) {
+                const X * points = x.data();
+                Y * y = values.data();
+                pool.parallel_for(
+                    x.n_elements(), std::max(1, _chunk / Q), [&](int begin, int end) {
+                        operator()(points + begin * Q, y + begin * Q, (end - begin) * Q);
+                    });
+            }
+
+            // all done
+            return values;
+        }
+
+      private:
+        // the number of points evaluated by a thread at once in a parallel evaluation
+        static constexpr int _chunk = 8 * batch_size;
+
+        // helper function: the function computed by {jet}
+        static function_t _value(const jet_functor_t & jet)
+        {
+            return function_t([jet](const X & x) {
+                Y y;
+                std::array<Y, D> Dy;
+                jet(x, y, Dy);
+                return y;
+            });
+        }
+
+        // helper function: the partial derivatives computed by {jet}
+        template <std::size_t... I>
+        static std::array<function_t, D> _partials(
+            const jet_functor_t & jet, std::index_sequence<I...>)
+        {
+            return { function_t([jet](const X & x) {
+                Y y;
+                std::array<Y, D> Dy;
+                jet(x, y, Dy);
+                return Dy[I];
+            })... };
+        }
+
+        // helper function: the value and the partial derivatives of {f} at {x}, by evaluating {f}
+        // on dual numbers
+        template <class F>
+        static void _differentiate(const F & f, const X & x, Y & y, std::array<Y, D> & Dy)
+        {
+            // the type of the values of {f} on dual numbers
+            using Z = typename rebind<Y, Dual<D, typename type<X>::value>>::value;
+
+            // evaluate {f} and all its partial derivatives in one pass
+            const Z z(f(seed(x)));
+
+            // unpack the values and the partial derivatives
+            for (int k = 0; k < size<Y>::value; ++k) {
+                y[k] = z[k].value();
+                for (int i = 0; i < D; ++i) {
+                    Dy[i][k] = z[k].gradient()[i];
+                }
+            }
+
+            // all done
+            return;
+        }
+
       public:
         // accessor for function
         inline const auto & f() const { return _f; }
@@ -96,23 +213,40 @@ namespace mito {
         inline const auto & Df(int i) const
         {
             // assert there exists the i-th partial derivative
-            assert(i < (int) _Df.size());
+            assert(i < (int) _Df.size() && _Df[i]);
             // return the i-th partial derivative
             return _Df[i];
         }
 
+        // whether all the partial derivatives of the function are available
+        inline bool differentiable() const
+        {
+            return std::all_of(_Df.begin(), _Df.end(), [](const auto & Df) { return bool(Df); });
+        }
+
+        // accessor for the functor computing the function and all its derivatives at once (empty
+        // if the field was not built from one)
+        inline const auto & jet() const { return _jet; }
+
+        // accessor for the identity of the field, shared by its copies (e.g. to memoize its values)
+        inline const auto & identity() const { return _identity; }
+
       private:
         // the function
         function_t _f;
         // the derivatives of f with respect to X (position in the reference configuration)
         std::array<function_t, D> _Df;
+        // the function and its derivatives computed at once (if available)
+        jet_functor_t _jet;
+        // the identity of the field (a token shared by its copies, which compute the same function)
+        std::shared_ptr<const char> _identity = std::make_shared<const char>();
     };
 
-    template <int D, int N>
-    using VectorField = Field<vector_t<D>, vector_t<N>>;
+    template <int D, int N, typename T = real>
+    using VectorField = Field<vector_t<D, T>, vector_t<N, T>>;
 
-    template <int D>
-    using ScalarField = Field<vector_t<D>, scalar_t<>>;
+    template <int D, typename T = real>
+    using ScalarField = Field<vector_t<D, T>, scalar_t<T>>;
 
     template <typename X, typename Y, std::size_t... I>
     inline auto _dSum(
@@ -125,81 +259,269 @@ namespace mito {
         return Df;
     }
 
+    // helper function: the functor computing the sum of two fields and all its derivatives at once,
+    // from those of the two fields
+    template <typename X, typename Y>
+    inline auto _jetSum(const Field<X, Y> & fieldA, const Field<X, Y> & fieldB)
+    {
+        // dimension of the X space
+        static constexpr int D = size<X>::value;
+
+        return typename Field<X, Y>::jet_functor_t(
+            [jetA = fieldA.jet(), jetB = fieldB.jet()](
+                const X & x, Y & y, std::array<Y, D> & Dy) {
+                Y yB;
+                std::array<Y, D> DyB;
+                jetA(x, y, Dy);
+                jetB(x, yB, DyB);
+                y += yB;
+                for (int i = 0; i < D; ++i) {
+                    Dy[i] += DyB[i];
+                }
+            });
+    }
+
+    // the sum of two fields, with its derivatives if both fields have them (and computed all at
+    // once if both fields compute them so)
     template <typename X, typename Y>
     auto operator+(const Field<X, Y> & fieldA, const Field<X, Y> & fieldB)
     {
         // dimension of the X space
         static constexpr int D = size<X>::value;
 
-        return Field<X, Y>(
-            fieldA.f() + fieldB.f(), _dSum(fieldA, fieldB, std::make_index_sequence<D> {}));
+        if (fieldA.jet() && fieldB.jet()) {
+            return Field<X, Y>(fieldA.f() + fieldB.f(), _jetSum(fieldA, fieldB));
+        }
+
+        if (fieldA.differentiable() && fieldB.differentiable()) {
+            return Field<X, Y>(
+                fieldA.f() + fieldB.f(), _dSum(fieldA, fieldB, std::make_index_sequence<D> {}));
+        }
+
+        // all done
+        return Field<X, Y>(fieldA.f() + fieldB.f());
     }
 
-    // helper function to compute the gradient of a vector field with respect to the reference
-    // configuration (template with index sequence)
-    template <int D, std::size_t... I>
-    inline auto _grad(
-        const ScalarField<D> & field, const vector_t<D> & x, std::index_sequence<I...>)
+    // Differential operators: the gradient, the divergence, the curl and the jacobian of a field
+    // are computed from its jacobian, assembled at each point in one pass through the jet of the
+    // field (if it has one), or in batch from its partial derivatives (if they all can be
+    // evaluated in batch), each evaluated once and read in full
+
+    // the jacobian of a field of {Y} over {X}: entry {i, j} is the derivative of component {i}
+    // with respect to coordinate {j}
+    template <typename X, typename Y>
+    using jacobian_t = tensor_t<size<Y>::value, size<X>::value, typename type<Y>::value>;
+
+    // helper function: the jacobian of {field} at {x}
+    template <typename X, typename Y>
+    inline auto _jacobian(const Field<X, Y> & field, const X & x)
     {
+        // dimension of the X space
+        constexpr int D = size<X>::value;
+        // dimension of the Y space
+        constexpr int N = size<Y>::value;
+
+        jacobian_t<X, Y> J;
+
+        // if the field computes all its derivatives at once, do so
+        if (field.jet()) {
+            Y y;
+            std::array<Y, D> Dy;
+            field.jet()(x, y, Dy);
+            for (int j = 0; j < D; ++j) {
+                for (int i = 0; i < N; ++i) {
+                    J[i * D + j] = Dy[j][i];
+                }
+            }
+            return J;
+        }
+
+        // otherwise, evaluate each partial derivative once
+        for (int j = 0; j < D; ++j) {
+            const Y Dyj = field.Df(j)(x);
+            for (int i = 0; i < N; ++i) {
+                J[i * D + j] = Dyj[i];
+            }
+        }
+
         // all done
-        return vector_t<D> { field.Df(I)(x)... };
+        return J;
     }
 
-    // function to compute the gradient of a scalar field with respect to the reference
-    // configuration at point x
-    template <int D>
-    inline auto grad(const ScalarField<D> & field, const vector_t<D> & x)
+    // helper function: whether the jacobians of {field} are assembled in batch, i.e. if all its
+    // partial derivatives can be evaluated in batch (and it does not compute them all at once)
+    template <typename X, typename Y>
+    inline bool _batched(const Field<X, Y> & field)
+    {
+        bool batched = !field.jet();
+        for (int j = 0; j < size<X>::value; ++j) {
+            batched = batched && field.Df(j).batched();
+        }
+        return batched;
+    }
+
+    // helper function: the jacobians of {field} at {n} contiguous points {x}, from its partial
+    // derivatives evaluated in batch
+    template <typename X, typename Y>
+    inline void _jacobian(const Field<X, Y> & field, const X * x, jacobian_t<X, Y> * J, int n)
     {
-        return _grad(field, x, std::make_index_sequence<D> {});
+        // dimension of the X space
+        constexpr int D = size<X>::value;
+        // dimension of the Y space
+        constexpr int N = size<Y>::value;
+
+        // evaluate each partial derivative in batch and scatter it to its column
+        std::array<Y, batch_size> values;
+        for (int b = 0; b < n; b += batch_size) {
+            int m = std::min(batch_size, n - b);
+            for (int j = 0; j < D; ++j) {
+                field.Df(j)(x + b, values.data(), m);
+                for (int k = 0; k < m; ++k) {
+                    for (int i = 0; i < N; ++i) {
+                        J[b + k][i * D + j] = values[k][i];
+                    }
+                }
+            }
+        }
+
+        // all done
+        return;
     }
 
-    // helper function to compute the gradient of a vector field with respect to the reference
-    // configuration (template with index sequence)
-    template <int D, std::size_t... I>
-    inline VectorField<D, D> _grad(const ScalarField<D> & field, std::index_sequence<I...>)
+    // helper function: the field of a differential operator, computed at each point by
+    // {pointwise(field, x)}, or by {op(J)} from the jacobians {J} of {field} assembled in batch
+    template <typename Z, typename X, typename Y, class P, class OP>
+    inline Field<X, Z> _differential(const Field<X, Y> & field, P pointwise, OP op)
     {
         // TOFIX: capturing field by copy or by reference? Is it better to capture
         // {field.Df(I)...} intead? Is it possible to do so?
-        return VectorField<D, D>(Function<vector_t<D>, vector_t<D>>(
-            [field](const vector_t<D> & x) { return vector_t<D> { field.Df(I)(x)... }; }));
+        return Field<X, Z>(Function<X, Z>(
+            [field, pointwise](const X & x) { return Z(pointwise(field, x)); },
+            [field, pointwise, op](const X * x, Z * z, int n) {
+                // if the jacobians cannot be assembled in batch, evaluate point by point
+                if (!_batched(field)) {
+                    for (int k = 0; k < n; ++k) {
+                        z[k] = pointwise(field, x[k]);
+                    }
+                    return;
+                }
+
+                // otherwise, assemble the jacobians in batch, then apply {op} to each of them
+                std::array<jacobian_t<X, Y>, batch_size> J;
+                for (int b = 0; b < n; b += batch_size) {
+                    int m = std::min(batch_size, n - b);
+                    _jacobian(field, x + b, J.data(), m);
+                    for (int k = 0; k < m; ++k) {
+                        z[b + k] = op(J[k]);
+                    }
+                }
+            }));
+    }
+
+    // helper function: the gradient of a scalar field from its jacobian (a single row)
+    template <int D, typename T>
+    constexpr auto _gradient(const tensor_t<1, D, T> & J)
+    {
+        vector_t<D, T> g;
+        for (int j = 0; j < D; ++j) {
+            g[j] = J[j];
+        }
+        return g;
+    }
+
+    // helper function: the curl of a 2D vector field from its jacobian
+    template <typename T>
+    constexpr auto _curl(const tensor_t<2, 2, T> & J)
+    {
+        return scalar_t<T>(J[2] - J[1]);
+    }
+
+    // helper function: the curl of a 3D vector field from its jacobian
+    template <typename T>
+    constexpr auto _curl(const tensor_t<3, 3, T> & J)
+    {
+        return vector_t<3, T> { J[7] - J[5], J[2] - J[6], J[3] - J[1] };
+    }
+
+    // function to compute the jacobian of a field with respect to the reference configuration at
+    // point x
+    template <typename X, typename Y>
+    inline auto jacobian(const Field<X, Y> & field, const X & x)
+    {
+        return _jacobian(field, x);
+    }
+
+    // function to compute the jacobian of a field with respect to the reference configuration
+    template <typename X, typename Y>
+    inline auto jacobian(const Field<X, Y> & field)
+    {
+        return _differential<jacobian_t<X, Y>>(
+            field, [](const auto & field, const X & x) { return jacobian(field, x); },
+            [](const jacobian_t<X, Y> & J) { return J; });
+    }
+
+    // function to compute the gradient of a scalar field with respect to the reference
+    // configuration at point x
+    template <int D, typename T>
+    inline auto grad(const ScalarField<D, T> & field, const vector_t<D, T> & x)
+    {
+        return _gradient(_jacobian(field, x));
     }
 
     // function to compute the gradient of a vector field with respect to the reference
     // configuration
-    template <int D>
-    inline VectorField<D, D> grad(const ScalarField<D> & field)
+    template <int D, typename T>
+    inline VectorField<D, D, T> grad(const ScalarField<D, T> & field)
     {
-        return _grad(field, std::make_index_sequence<D> {});
+        return _differential<vector_t<D, T>>(
+            field, [](const auto & field, const vector_t<D, T> & x) { return grad(field, x); },
+            [](const tensor_t<1, D, T> & J) { return _gradient(J); });
     }
 
     // function to compute the Divergence of a vector field at point X
-    template <int D>
-    inline real div(const VectorField<D, D> & field, const vector_t<D> & X)
+    template <int D, typename T>
+    inline T div(const VectorField<D, D, T> & field, const vector_t<D, T> & X)
     {
-        real result = 0.0;
+        // if the field computes all its derivatives at once, do so
+        if (field.jet()) {
+            return ComputeTrace(_jacobian(field, X));
+        }
+
+        // otherwise, only read the diagonal of the jacobian
+        T result = 0.0;
         for (int i = 0; i < D; ++i) {
             result += field.Df(i)(X)[i];
         }
         return result;
     }
 
-    // helper function to compute the divergence of a vector field with respect to the reference
-    // configuration at point X (template with index sequence)
-    template <int D, std::size_t... I>
-    inline ScalarField<D> _div(const VectorField<D, D> & field, std::index_sequence<I...>)
+    // function to compute the divergence of a vector field with respect to the reference
+    // configuration at point X
+    template <int D, typename T>
+    inline ScalarField<D, T> div(const VectorField<D, D, T> & field)
     {
-        // TOFIX: capturing field by copy or by reference? Is it better to capture
-        // {field.Df(I)...} intead? Is it possible to do so?
-        return ScalarField<D>(Function<vector_t<D>>(
-            [field](const vector_t<D> & x) { return (field.Df(I)(x)[I] + ...); }));
+        return _differential<scalar_t<T>>(
+            field, [](const auto & field, const vector_t<D, T> & x) { return div(field, x); },
+            [](const tensor_t<D, D, T> & J) { return scalar_t<T>(ComputeTrace(J)); });
     }
 
-    // function to compute the divergence of a vector field with respect to the reference
-    // configuration at point X
-    template <int D>
-    inline ScalarField<D> div(const VectorField<D, D> & field)
+    // function to compute the curl of a 2D or 3D vector field at point x (a scalar in 2D)
+    template <int D, typename T>
+    inline auto curl(const VectorField<D, D, T> & field, const vector_t<D, T> & x) requires(
+        D == 2 || D == 3)
+    {
+        return _curl(_jacobian(field, x));
+    }
+
+    // function to compute the curl of a 2D or 3D vector field with respect to the reference
+    // configuration (a scalar field in 2D)
+    template <int D, typename T>
+    inline auto curl(const VectorField<D, D, T> & field) requires(D == 2 || D == 3)
     {
-        return _div(field, std::make_index_sequence<D> {});
+        using curl_t = decltype(_curl(std::declval<tensor_t<D, D, T>>()));
+        return _differential<curl_t>(
+            field, [](const auto & field, const vector_t<D, T> & x) { return curl(field, x); },
+            [](const tensor_t<D, D, T> & J) { return _curl(J); });
     }
 }
 
@@ -11,13 +11,36 @@ namespace mito {
     template <typename X, typename Y = scalar_t<>>
     using functor = std::function<Y(const X &)>;
 
+    // templatized typedef for batch functors: evaluate at {n} contiguous points {x} and write the
+    // {n} values in {y}
+    template <typename X, typename Y = scalar_t<>>
+    using batch_functor = std::function<void(const X * x, Y * y, int n)>;
+
+    // the number of points the batched compositions of functions evaluate at once (i.e. the size
+    // of their scratch buffers)
+    inline constexpr int batch_size = 128;
+
     // We need a class function to explicitly put the return value Y in the template
     template <typename X, typename Y = scalar_t<>>
     class Function {
 
       public:
-        inline Function(const functor<X, Y> & f) : _functor(f) {}
-        inline Function(functor<X, Y> && f) : _functor(f) {}
+        inline Function(const functor<X, Y> & f) : _functor(f), _batch() {}
+        inline Function(functor<X, Y> && f) : _functor(f), _batch() {}
+        // constructor with a batch functor (evaluated at a single point through a batch of one)
+        inline Function(const batch_functor<X, Y> & batch) :
+            _functor([batch](const X & x) {
+                Y y;
+                batch(&x, &y, 1);
+                return y;
+            }),
+            _batch(batch)
+        {}
+        // constructor with both the pointwise and the batch functor
+        inline Function(const functor<X, Y> & f, const batch_functor<X, Y> & batch) :
+            _functor(f),
+            _batch(batch)
+        {}
         // default constructor
         inline Function() = default;
         // copy constructor
@@ -35,34 +58,104 @@ namespace mito {
             return _functor(x);
         }
 
+        // evaluate at {n} contiguous points {x} and write the {n} values in {y}
+        inline void operator()(const X * x, Y * y, int n) const
+        {
+            // if there is a batch functor, evaluate all points at once
+            if (_batch) {
+                return _batch(x, y, n);
+            }
+
+            // otherwise, evaluate point by point
+            for (int k = 0; k < n; ++k) {
+                y[k] = _functor(x[k]);
+            }
+
+            // all done
+            return;
+        }
+
         inline auto operator[](int i) const
         {
-            return Function<X, scalar_t<real>>(
+            return Function<X, scalar_t<typename type<Y>::value>>(
                 [this, i](const X & x) { return this->_functor(x)[i]; });
         }
 
+        // whether the function has been assigned a functor
+        inline explicit operator bool() const { return bool(_functor); }
+
+        // whether the function has a batch functor
+        inline bool batched() const { return bool(_batch); }
+
         // cast operator from Function<X, Y> to functor<X, Y>
         inline operator functor<X, Y>() const { return _functor; }
 
       private:
         const functor<X, Y> _functor;
+        const batch_functor<X, Y> _batch;
     };
 
-    // Algebraic operations on Function
-    // TODO: see if expression templates can be used to avoid copies with intermediate results
+    // helper function: evaluate {f} at {n} points {x}, block by block, and write {op(f(x))} in {y}
+    template <typename X, typename Y, typename Z, class OP>
+    inline void _transform(const Function<X, Y> & f, const X * x, Z * y, int n, OP op)
+    {
+        std::array<Y, batch_size> values;
+        for (int b = 0; b < n; b += batch_size) {
+            int m = std::min(batch_size, n - b);
+            f(x + b, values.data(), m);
+            for (int k = 0; k < m; ++k) {
+                y[b + k] = op(values[k]);
+            }
+        }
+
+        // all done
+        return;
+    }
+
+    // helper function: evaluate {fA} and {fB} at {n} points {x}, block by block, and write
+    // {op(fA(x), fB(x))} in {y}
+    template <typename X, typename YA, typename YB, typename Z, class OP>
+    inline void _transform(
+        const Function<X, YA> & fA, const Function<X, YB> & fB, const X * x, Z * y, int n, OP op)
+    {
+        std::array<YA, batch_size> valuesA;
+        std::array<YB, batch_size> valuesB;
+        for (int b = 0; b < n; b += batch_size) {
+            int m = std::min(batch_size, n - b);
+            fA(x + b, valuesA.data(), m);
+            fB(x + b, valuesB.data(), m);
+            for (int k = 0; k < m; ++k) {
+                y[b + k] = op(valuesA[k], valuesB[k]);
+            }
+        }
+
+        // all done
+        return;
+    }
+
+    // Algebraic operations on Function: each composition also composes the batch evaluation, so
+    // that evaluating a composed function at many points runs one tight loop per operation
 
     // fa + fb
     template <typename X, typename Y>
     Function<X, Y> operator+(const Function<X, Y> & fA, const Function<X, Y> & fB)
     {
-        return Function<X, Y>([fA, fB](const X & x) { return fA(x) + fB(x); });
+        return Function<X, Y>(
+            [fA, fB](const X & x) { return fA(x) + fB(x); },
+            [fA, fB](const X * x, Y * y, int n) {
+                _transform(fA, fB, x, y, n, [](const Y & a, const Y & b) { return a + b; });
+            });
     }
 
     // fa * fb
     template <typename X, typename Y>
     Function<X, Y> operator*(const Function<X, Y> & fA, const Function<X, Y> & fB)
     {
-        return Function<X, Y>([fA, fB](const X & x) { return fA(x) * fB(x); });
+        return Function<X, Y>(
+            [fA, fB](const X & x) { return fA(x) * fB(x); },
+            [fA, fB](const X * x, Y * y, int n) {
+                _transform(fA, fB, x, y, n, [](const Y & a, const Y & b) { return Y(a * b); });
+            });
     }
 
     // y * f (inner product)
@@ -70,7 +163,12 @@ namespace mito {
     Function<X, typename type<Y>::value> operator*(const Y & y, const Function<X, Y> & f) requires(
         Y::S != 1)
     {
-        return Function<X, typename type<Y>::value>([y, f](const X & x) { return y * f(x); });
+        using T = typename type<Y>::value;
+        return Function<X, T>(
+            [y, f](const X & x) { return y * f(x); },
+            [y, f](const X * x, T * z, int n) {
+                _transform(f, x, z, n, [&y](const Y & b) { return T(y * b); });
+            });
     }
 
     // f * y (inner product)
@@ -83,30 +181,35 @@ namespace mito {
 
     // a * f
     template <typename X, typename Y>
-    Function<X, Y> operator*(const real & a, const Function<X, Y> & f)
+    Function<X, Y> operator*(const typename type<Y>::value & a, const Function<X, Y> & f)
     {
-        return Function<X, Y>([a, f](const X & x) { return a * f(x); });
+        return Function<X, Y>(
+            [a, f](const X & x) { return a * f(x); },
+            [a, f](const X * x, Y * y, int n) {
+                _transform(f, x, y, n, [&a](const Y & b) { return a * b; });
+            });
     }
 
     // f * a
     template <typename X, typename Y>
-    Function<X, Y> operator*(const Function<X, Y> & f, const real & a)
+    Function<X, Y> operator*(const Function<X, Y> & f, const typename type<Y>::value & a)
     {
         return a * f;
     }
 
     // f / a
     template <typename X, typename Y>
-    Function<X, Y> operator/(const Function<X, Y> & f, const real & a)
+    Function<X, Y> operator/(const Function<X, Y> & f, const typename type<Y>::value & a)
     {
-        return (1.0 / a) * f;
+        using T = typename type<Y>::value;
+        return (T(1) / a) * f;
     }
 
     // -f
     template <typename X, typename Y>
     Function<X, Y> operator-(const Function<X, Y> & f)
     {
-        return -1.0 * f;
+        return typename type<Y>::value(-1) * f;
     }
 
     // fa - fb
@@ -118,43 +221,62 @@ namespace mito {
 
     // Special algebraic functions for scalar functions
     // a / f
-    template <typename X>
-    Function<X, scalar_t<real>> operator/(const real & a, const Function<X, scalar_t<real>> & f)
+    template <typename X, typename T>
+    Function<X, scalar_t<T>> operator/(
+        const std::type_identity_t<T> & a, const Function<X, scalar_t<T>> & f)
     {
-        return Function<X, scalar_t<real>>([a, f](const X & x) { return a / f(x); });
+        return Function<X, scalar_t<T>>(
+            [a, f](const X & x) { return a / f(x); },
+            [a, f](const X * x, scalar_t<T> * y, int n) {
+                _transform(f, x, y, n, [&a](const scalar_t<T> & b) { return a / b; });
+            });
     }
 
     // f1 / f2
     template <typename X, typename Y>
-    Function<X, Y> operator/(const Function<X, Y> & f1, const Function<X, scalar_t<real>> & f2)
+    Function<X, Y> operator/(
+        const Function<X, Y> & f1, const Function<X, scalar_t<typename type<Y>::value>> & f2)
     {
-        return Function<X, Y>([f1, f2](const X & x) { return f1(x) / f2(x); });
+        using S = scalar_t<typename type<Y>::value>;
+        return Function<X, Y>(
+            [f1, f2](const X & x) { return f1(x) / f2(x); },
+            [f1, f2](const X * x, Y * y, int n) {
+                _transform(f1, f2, x, y, n, [](const Y & a, const S & b) { return Y(a / b); });
+            });
     }
 
     // a + f
-    template <typename X>
-    Function<X, scalar_t<real>> operator+(const real & a, const Function<X, scalar_t<real>> & f)
+    template <typename X, typename T>
+    Function<X, scalar_t<T>> operator+(
+        const std::type_identity_t<T> & a, const Function<X, scalar_t<T>> & f)
     {
-        return Function<X, scalar_t<real>>([a, f](const X & x) { return a + f(x); });
+        return Function<X, scalar_t<T>>(
+            [a, f](const X & x) { return a + f(x); },
+            [a, f](const X * x, scalar_t<T> * y, int n) {
+                _transform(f, x, y, n, [&a](const scalar_t<T> & b) { return a + b; });
+            });
     }
 
     // f + a
-    template <typename X>
-    Function<X, scalar_t<real>> operator+(const Function<X, scalar_t<real>> & f, const real & a)
+    template <typename X, typename T>
+    Function<X, scalar_t<T>> operator+(
+        const Function<X, scalar_t<T>> & f, const std::type_identity_t<T> & a)
     {
         return a + f;
     }
 
     // a - f
-    template <typename X>
-    Function<X, scalar_t<real>> operator-(const real & a, const Function<X, scalar_t<real>> & f)
+    template <typename X, typename T>
+    Function<X, scalar_t<T>> operator-(
+        const std::type_identity_t<T> & a, const Function<X, scalar_t<T>> & f)
     {
         return a + (-f);
     }
 
     // f - a
-    template <typename X>
-    Function<X, scalar_t<real>> operator-(const Function<X, scalar_t<real>> & f, const real & a)
+    template <typename X, typename T>
+    Function<X, scalar_t<T>> operator-(
+        const Function<X, scalar_t<T>> & f, const std::type_identity_t<T> & a)
     {
         return f + (-a);
     }
@@ -204,16 +326,18 @@ namespace mito {
 
     // f1 / f2
     template <typename X, typename Y>
-    Function<X, Y> operator/(const Function<X, Y> & f1, const functor<X, scalar_t<real>> & f2)
+    Function<X, Y> operator/(
+        const Function<X, Y> & f1, const functor<X, scalar_t<typename type<Y>::value>> & f2)
     {
-        return Function<X, Y>([f1, f2](const X & x) { return f1(x) / f2(x); });
+        return f1 / Function<X, scalar_t<typename type<Y>::value>>(f2);
     }
 
     // f1 / f2
     template <typename X, typename Y>
-    Function<X, Y> operator/(const functor<X, Y> & f1, const Function<X, scalar_t<real>> & f2)
+    Function<X, Y> operator/(
+        const functor<X, Y> & f1, const Function<X, scalar_t<typename type<Y>::value>> & f2)
     {
-        return Function<X, Y>([f1, f2](const X & x) { return f1(x) / f2(x); });
+        return Function<X, Y>(f1) / f2;
     }
 
     // Binary operators for Y(const X &) and Function<X, Y>, such as:
@@ -261,16 +385,17 @@ namespace mito {
 
     // f1 / f2
     template <typename X, typename Y>
-    Function<X, Y> operator/(const Function<X, Y> & f1, real f2(const X &))
+    Function<X, Y> operator/(const Function<X, Y> & f1, typename type<Y>::value f2(const X &))
     {
         return Function<X, Y>([f1, f2](const X & x) { return f1(x) / f2(x); });
     }
 
     // f1 / f2
     template <typename X, typename Y>
-    Function<X, Y> operator/(Y f1(const X &), const Function<X, scalar_t<real>> & f2)
+    Function<X, Y> operator/(
+        Y f1(const X &), const Function<X, scalar_t<typename type<Y>::value>> & f2)
     {
-        return Function<X, Y>([f1, f2](const X & x) { return f1(x) / f2(x); });
+        return Function<X, Y>(f1) / f2;
     }
 }
 
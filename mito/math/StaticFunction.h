@@ -0,0 +1,208 @@
+// code guard
+#if !defined(mito_math_StaticFunction_h)
+#define mito_math_StaticFunction_h
+
+#include "../mito.h"
+
+// Statically typed functions: unlike Function, which type-erases its callable in a std::function,
+// a StaticFunction keeps the concrete type of its callable, and so do its algebraic compositions.
+// An expression like {a - f * g} is then a single callable the compiler inlines into one kernel,
+// instead of a chain of indirect calls. A StaticFunction is itself a callable, so it is
+// type-erased only where needed, at API boundaries, by constructing a Function or a Field from it.
+
+namespace mito {
+
+    template <typename X, class F>
+    class StaticFunction;
+
+    // a static function of {X} with callable {f}
+    template <typename X, class F>
+    constexpr auto function(F && f)
+    {
+        return StaticFunction<X, std::remove_cvref_t<F>>(std::forward<F>(f));
+    }
+
+    // helper function: evaluate expressions on grids, leave any other value untouched
+    template <class Y>
+    constexpr auto _evaluate(Y && y)
+    {
+        if constexpr (requires { y.evaluate(); }) {
+            return y.evaluate();
+        } else {
+            return std::remove_cvref_t<Y>(std::forward<Y>(y));
+        }
+    }
+
+    // a function from X to the output of the callable F
+    template <typename X, class F>
+    class StaticFunction {
+
+      public:
+        // the input type
+        using input_type = X;
+        // the output type
+        using output_type =
+            decltype(_evaluate(std::declval<const F &>()(std::declval<const X &>())));
+        // the underlying scalar type of the output
+        using scalar_type = typename type<output_type>::value;
+
+      public:
+        constexpr StaticFunction(const F & f) : _f(f) {}
+        constexpr StaticFunction(F && f) : _f(std::move(f)) {}
+
+        constexpr output_type operator()(const X & x) const
+        {
+            // evaluate _f
+            return _evaluate(_f(x));
+        }
+
+        // the i-th component of the function
+        constexpr auto operator[](int i) const
+        {
+            return function<X>([f = _f, i](const X & x) { return _evaluate(f(x))[i]; });
+        }
+
+      private:
+        // the callable
+        F _f;
+    };
+
+    // helper trait: whether {F} is a static function
+    template <class F>
+    struct is_static_function : std::false_type {};
+
+    template <typename X, class F>
+    struct is_static_function<StaticFunction<X, F>> : std::true_type {};
+
+    // a static function
+    template <class F>
+    concept static_function = is_static_function<std::remove_cvref_t<F>>::value;
+
+    // two static functions of the same input type
+    template <class F1, class F2>
+    concept same_input = static_function<F1> && static_function<F2>
+                      && std::is_same_v<
+                             typename std::remove_cvref_t<F1>::input_type,
+                             typename std::remove_cvref_t<F2>::input_type>;
+
+    // Algebraic operations on static functions: each returns a static function whose callable
+    // captures (copies of) the operands, so that the composition keeps all the concrete types
+
+    // fa + fb
+    template <class F1, class F2>
+    constexpr auto operator+(const F1 & fA, const F2 & fB) requires(same_input<F1, F2>)
+    {
+        using X = typename F1::input_type;
+        return function<X>([fA, fB](const X & x) { return _evaluate(fA(x) + fB(x)); });
+    }
+
+    // fa - fb
+    template <class F1, class F2>
+    constexpr auto operator-(const F1 & fA, const F2 & fB) requires(same_input<F1, F2>)
+    {
+        using X = typename F1::input_type;
+        return function<X>([fA, fB](const X & x) { return _evaluate(fA(x) - fB(x)); });
+    }
+
+    // fa * fb
+    template <class F1, class F2>
+    constexpr auto operator*(const F1 & fA, const F2 & fB) requires(same_input<F1, F2>)
+    {
+        using X = typename F1::input_type;
+        return function<X>([fA, fB](const X & x) { return _evaluate(fA(x) * fB(x)); });
+    }
+
+    // fa / fb (with fb a scalar function)
+    template <class F1, class F2>
+    constexpr auto operator/(const F1 & fA, const F2 & fB) requires(same_input<F1, F2>)
+    {
+        using X = typename F1::input_type;
+        return function<X>([fA, fB](const X & x) {
+            return _evaluate(fA(x) / typename F2::scalar_type(fB(x)));
+        });
+    }
+
+    // -f
+    template <class F>
+    constexpr auto operator-(const F & f) requires(static_function<F>)
+    {
+        using X = typename F::input_type;
+        return function<X>([f](const X & x) { return _evaluate(-f(x)); });
+    }
+
+    // a * f
+    template <class F>
+    constexpr auto operator*(const typename F::scalar_type & a, const F & f) requires(
+        static_function<F>)
+    {
+        using X = typename F::input_type;
+        return function<X>([a, f](const X & x) { return _evaluate(a * f(x)); });
+    }
+
+    // f * a
+    template <class F>
+    constexpr auto operator*(const F & f, const typename F::scalar_type & a) requires(
+        static_function<F>)
+    {
+        return a * f;
+    }
+
+    // f / a
+    template <class F>
+    constexpr auto operator/(const F & f, const typename F::scalar_type & a) requires(
+        static_function<F>)
+    {
+        using T = typename F::scalar_type;
+        return (T(1) / a) * f;
+    }
+
+    // Special algebraic functions for scalar functions
+    // a + f
+    template <class F>
+    constexpr auto operator+(const typename F::scalar_type & a, const F & f) requires(
+        static_function<F> && size<typename F::output_type>::value == 1)
+    {
+        using X = typename F::input_type;
+        using T = typename F::scalar_type;
+        return function<X>([a, f](const X & x) { return a + T(f(x)); });
+    }
+
+    // f + a
+    template <class F>
+    constexpr auto operator+(const F & f, const typename F::scalar_type & a) requires(
+        static_function<F> && size<typename F::output_type>::value == 1)
+    {
+        return a + f;
+    }
+
+    // a - f
+    template <class F>
+    constexpr auto operator-(const typename F::scalar_type & a, const F & f) requires(
+        static_function<F> && size<typename F::output_type>::value == 1)
+    {
+        return a + (-f);
+    }
+
+    // f - a
+    template <class F>
+    constexpr auto operator-(const F & f, const typename F::scalar_type & a) requires(
+        static_function<F> && size<typename F::output_type>::value == 1)
+    {
+        return f + (-a);
+    }
+
+    // a / f
+    template <class F>
+    constexpr auto operator/(const typename F::scalar_type & a, const F & f) requires(
+        static_function<F> && size<typename F::output_type>::value == 1)
+    {
+        using X = typename F::input_type;
+        using T = typename F::scalar_type;
+        return function<X>([a, f](const X & x) { return a / T(f(x)); });
+    }
+
+}    // namespace mito
+
+#endif    // mito_math_StaticFunction_h
+
+// end of file
@@ -0,0 +1,259 @@
+// code guard
+#if !defined(mito_math_TimeDependentField_h)
+#define mito_math_TimeDependentField_h
+
+#include <cmath>
+#include <limits>
+#include "Field.h"
+#include "../mito.h"
+#include "../elements/QuadratureField.h"
+
+namespace mito {
+
+    // how a field depends on time
+    enum class TimeDependence {
+        // f(x, t) = f(x)
+        CONSTANT,
+        // f(x, t) = f(x) g(t)
+        SEPARABLE,
+        // f(x, t)
+        GENERAL
+    };
+
+    // f(X,t) with (X \in R^D, t \in R) -> Y, with a declared dependence on time
+    template <typename X, typename Y = scalar_t<>>
+    class TimeDependentField {
+
+        // typedef for the field of the spatial part
+        using field_t = Field<X, Y>;
+        // typedef for a function of time
+        using time_function_t = std::function<real(real)>;
+        // typedef for a function of space and time (e.g. a {mito::field})
+        using functor_t = std::function<Y(const X &, real)>;
+
+      public:
+        // typedef for a function of space and time evaluated in batch: at the {n} contiguous
+        // points {x} at time {t}, writing the {n} values in {y}
+        using batch_functor_t = std::function<void(const X * x, real t, Y * y, int n)>;
+
+      public:
+        // constructor of a field constant in time: f(x, t) = f(x)
+        TimeDependentField(const field_t & f) :
+            _dependence(TimeDependence::CONSTANT),
+            _f(f),
+            _g([](real) { return 1.0; }),
+            _h()
+        {}
+
+        // constructor of a separable field: f(x, t) = f(x) g(t)
+        TimeDependentField(const field_t & f, const time_function_t & g) :
+            _dependence(TimeDependence::SEPARABLE),
+            _f(f),
+            _g(g),
+            _h()
+        {}
+
+        // constructor of a general field f(x, t) (its spatial part is the field at t = 0)
+        TimeDependentField(const functor_t & h) :
+            TimeDependentField(batch_functor_t([h](const X * x, real t, Y * y, int n) {
+                for (int i = 0; i < n; ++i) {
+                    y[i] = h(x[i], t);
+                }
+            }))
+        {}
+
+        // constructor of a general field f(x, t) evaluated in batch (its spatial part is the field
+        // at t = 0)
+        TimeDependentField(const batch_functor_t & h) :
+            _dependence(TimeDependence::GENERAL),
+            _f(batch_functor<X, Y>([h](const X * x, Y * y, int n) { h(x, 0.0, y, n); })),
+            _g(),
+            _h(h)
+        {}
+
+      public:
+        // evaluate at point {x} and time {t}
+        inline Y operator()(const X & x, real t) const
+        {
+            if (_dependence == TimeDependence::GENERAL) {
+                Y y;
+                _h(&x, t, &y, 1);
+                return y;
+            }
+            if (_dependence == TimeDependence::SEPARABLE) {
+                return Y(_g(t) * _f(x));
+            }
+            return _f(x);
+        }
+
+        // evaluate at the {n} contiguous points {x} at time {t} and write the {n} values in {y}
+        inline void operator()(const X * x, real t, Y * y, int n) const
+        {
+            if (_dependence == TimeDependence::GENERAL) {
+                return _h(x, t, y, n);
+            }
+            _f(x, y, n);
+            if (_dependence == TimeDependence::SEPARABLE) {
+                const real g = _g(t);
+                for (int i = 0; i < n; ++i) {
+                    y[i] = Y(g * y[i]);
+                }
+            }
+
+            // all done
+            return;
+        }
+
+        // evaluate at all the points {x} at time {t}
+        inline auto operator()(const std::vector<X> & x, real t) const
+        {
+            std::vector<Y> values(x.size());
+            operator()(x.data(), t, values.data(), (int) x.size());
+            return values;
+        }
+
+        // accessor for the dependence on time
+        inline TimeDependence dependence() const { return _dependence; }
+
+        // accessor for the spatial part
+        inline const auto & f() const { return _f; }
+
+        // accessor for the temporal part (of a constant or separable field)
+        inline const auto & g() const { return _g; }
+
+        // accessor for the function of space and time, evaluated in batch (of a general field)
+        inline const auto & h() const { return _h; }
+
+      private:
+        // the dependence on time
+        TimeDependence _dependence;
+        // the spatial part
+        field_t _f;
+        // the temporal part
+        time_function_t _g;
+        // the function of space and time, evaluated in batch
+        batch_functor_t _h;
+    };
+
+    // the values of a time dependent field at a fixed set of points (e.g. the quadrature points of
+    // an integrator, or the nodes of a boundary): the spatial part is evaluated once at the points,
+    // so that at each time step a constant field costs nothing, a separable field costs a rescaling
+    // of the cached values, and only a general field is evaluated again
+    template <typename X, typename Y, class points_t>
+    class CachedField {
+
+        // typedef for the values at the points (a std::vector or a quadrature field)
+        using values_t = decltype(std::declval<Field<X, Y>>()(std::declval<points_t>()));
+        // typedef for the entries of the values
+        using T = typename type<Y>::value;
+
+      public:
+        /**
+         * constructor
+         * @param[in] field the time dependent field
+         * @param[in] points the points (referenced, not copied: they must outlive the cache)
+         */
+        CachedField(const TimeDependentField<X, Y> & field, const points_t & points) :
+            _field(field),
+            _points(points),
+            _cache(_spatialPart(field, points)),
+            _values(_allocate(points, field.dependence() != TimeDependence::CONSTANT)),
+            _time(std::numeric_limits<real>::quiet_NaN())
+        {}
+
+      public:
+        // the values of the field at the points at time {t}
+        inline const values_t & operator()(real t)
+        {
+            // a constant field is the cached spatial part
+            if (_field.dependence() == TimeDependence::CONSTANT) {
+                return _cache;
+            }
+
+            // the values are already at time {t}
+            if (t == _time) {
+                return _values;
+            }
+
+            int n = _count(_points);
+            Y * values = _values.data();
+
+            // a separable field is the spatial part rescaled by the temporal part
+            if (_field.dependence() == TimeDependence::SEPARABLE) {
+                const T g = _field.g()(t);
+                const Y * cache = _cache.data();
+                for (int i = 0; i < n; ++i) {
+                    for (int k = 0; k < size<Y>::value; ++k) {
+                        values[i][k] = g * cache[i][k];
+                    }
+                }
+            }
+            // a general field is evaluated again, in batch
+            else {
+                _field(_points.data(), t, values, n);
+            }
+
+            // remember the time of the values
+            _time = t;
+
+            // all done
+            return _values;
+        }
+
+        // accessor for the dependence on time
+        inline TimeDependence dependence() const { return _field.dependence(); }
+
+      private:
+        // helper function: the spatial part of {field} at {points} (none for a general field,
+        // which is evaluated at each time instead)
+        static inline values_t _spatialPart(
+            const TimeDependentField<X, Y> & field, const points_t & points)
+        {
+            if (field.dependence() == TimeDependence::GENERAL) {
+                return _allocate(points, false);
+            }
+            return field.f()(points);
+        }
+
+        // helper function: storage for the values at a vector of points (empty if not {needed})
+        static inline auto _allocate(const std::vector<X> & points, bool needed)
+        {
+            return std::vector<Y>(needed ? points.size() : 0);
+        }
+
+        // helper function: storage for the values at a quadrature field of points (not a copy of
+        // the cache, with which it would share its memory; empty if not {needed})
+        template <int Q>
+        static inline auto _allocate(const quadrature_field_t<Q, X> & points, bool needed)
+        {
+            return quadrature_field_t<Q, Y>(needed ? points.n_elements() : 0);
+        }
+
+        // helper function: the number of points in a vector of points
+        static inline int _count(const std::vector<X> & points) { return points.size(); }
+
+        // helper function: the number of points in a quadrature field
+        template <int Q>
+        static inline int _count(const quadrature_field_t<Q, X> & points)
+        {
+            return points.n_elements() * Q;
+        }
+
+      private:
+        // the time dependent field
+        TimeDependentField<X, Y> _field;
+        // the points
+        const points_t & _points;
+        // the spatial part at the points
+        values_t _cache;
+        // the values at the points at time {_time}
+        values_t _values;
+        // the time of the values
+        real _time;
+    };
+
+}    // namespace mito
+
+#endif    // mito_math_TimeDependentField_h
+
+// end of file
@@ -0,0 +1,175 @@
+// code guard
+#if !defined(mito_mesh_Arena_h)
+#define mito_mesh_Arena_h
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include "../mito.h"
+
+namespace mito {
+
+    // An arena of objects of type T: the objects are constructed in place, one after the other, in
+    // blocks of contiguous storage, they never move (so pointers to them stay valid) and they are
+    // all destroyed (and their storage released) together with the arena. Reserving room for the
+    // objects to come, when their number is known, puts them all in one block.
+    template <class T>
+    class Arena {
+
+      private:
+        // a block of storage for {capacity} objects, the first {count} of which are constructed (a
+        // block is only filled while it is the last one, so the index of its first object is the
+        // number of objects in the arena when it was added)
+        struct block_t {
+            T * data;
+            int count;
+            int capacity;
+            int first;
+        };
+
+      public:
+        /**
+         * constructor
+         * @param[in] blockSize the number of objects in a block (unless reserved otherwise)
+         */
+        inline Arena(int blockSize = 4096) :
+            _blocks(),
+            _sorted(),
+            _size(0),
+            _blockSize(blockSize)
+        {}
+
+        // destructor
+        inline ~Arena()
+        {
+            // destroy the objects and release the blocks
+            std::allocator<T> allocator;
+            for (auto & block : _blocks) {
+                std::destroy_n(block.data, block.count);
+                allocator.deallocate(block.data, block.capacity);
+            }
+
+            // all done
+            return;
+        }
+
+      private:
+        // delete copy constructor
+        Arena(const Arena &) = delete;
+
+        // delete move constructor
+        Arena(const Arena &&) = delete;
+
+        // delete assignment operator
+        const Arena & operator=(const Arena &) = delete;
+
+        // delete move assignment operator
+        const Arena & operator=(const Arena &&) = delete;
+
+      public:
+        // make room for {n} more objects in contiguous storage
+        inline void reserve(int n)
+        {
+            if (_blocks.empty() || _blocks.back().capacity - _blocks.back().count < n) {
+                _addBlock(std::max(n, 1));
+            }
+
+            // all done
+            return;
+        }
+
+        // construct a new object with arguments {args}
+        template <class... Args>
+        inline T * create(Args &&... args)
+        {
+            // start a new block if the current one is full
+            if (_blocks.empty() || _blocks.back().count == _blocks.back().capacity) {
+                _addBlock(_blockSize);
+            }
+
+            // construct the object in place
+            block_t & block = _blocks.back();
+            T * object = std::construct_at(block.data + block.count, std::forward<Args>(args)...);
+            ++block.count;
+            ++_size;
+
+            // all done
+            return object;
+        }
+
+        // the index of {object} in the arena (objects are numbered in order of construction),
+        // found by binary search over the start addresses of the blocks
+        inline int index(const T * object) const
+        {
+            std::less<const T *> less;
+            // the first block starting after {object}
+            auto next = std::upper_bound(
+                _sorted.begin(), _sorted.end(), object,
+                [this, &less](const T * ptr, int b) { return less(ptr, _blocks[b].data); });
+
+            // {object} is in the block before it, if anywhere
+            if (next != _sorted.begin()) {
+                const block_t & block = _blocks[*std::prev(next)];
+                if (less(object, block.data + block.count)) {
+                    return block.first + (object - block.data);
+                }
+            }
+
+            // the object is not in the arena
+            assert(false);
+            return -1;
+        }
+
+        // the number of objects
+        inline int size() const { return _size; }
+
+        // the number of blocks
+        inline int blocks() const { return _blocks.size(); }
+
+        // the bytes of storage held by the arena
+        inline std::size_t bytes() const
+        {
+            std::size_t bytes = 0;
+            for (const auto & block : _blocks) {
+                bytes += block.capacity * sizeof(T);
+            }
+            return bytes;
+        }
+
+      private:
+        // helper function: add a block of storage for {capacity} objects
+        inline void _addBlock(int capacity)
+        {
+            _blocks.push_back({ std::allocator<T>().allocate(capacity), 0, capacity, _size });
+
+            // keep the blocks sorted by start address
+            int b = _blocks.size() - 1;
+            std::less<const T *> less;
+            _sorted.insert(
+                std::upper_bound(
+                    _sorted.begin(), _sorted.end(), b,
+                    [this, &less](int a, int c) { return less(_blocks[a].data, _blocks[c].data); }),
+                b);
+
+            // all done
+            return;
+        }
+
+      private:
+        // the blocks of storage
+        std::vector<block_t> _blocks;
+        // the indices of the blocks, in order of start address
+        std::vector<int> _sorted;
+        // the number of objects
+        int _size;
+        // the default number of objects in a block
+        int _blockSize;
+    };
+
+}    // namespace mito
+
+#endif    // mito_mesh_Arena_h
+
+// end of file
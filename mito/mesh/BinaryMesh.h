@@ -0,0 +1,218 @@
+// code guard
+#if !defined(mito_mesh_BinaryMesh_h)
+#define mito_mesh_BinaryMesh_h
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../mito.h"
+
+namespace mito {
+
+    // The binary mesh format (version 1): a header followed by the arrays of the mesh, in the byte
+    // order of the machine that wrote it, each starting at a multiple of 8 bytes from the beginning
+    // of the file so that they can be read in place from the mapped file:
+    //  - the coordinates of the vertices (dim reals per vertex)
+    //  - for each dimension I = 1, ..., dim, the compositions of the entities of dimension I (the
+    //    I + 1 indices of their entities of dimension I - 1, as 32-bit integers)
+    //  - the label of each element (the index of its element set, as a 32-bit integer)
+    //  - the names of the element sets (each followed by a null character)
+    struct binary_mesh_header_t {
+        // the magic string identifying the format
+        char magic[8];
+        // the version of the format
+        std::uint32_t version;
+        // a known value, to detect files written with another byte order
+        std::uint32_t byteOrder;
+        // the dimension of the mesh
+        std::uint32_t dim;
+        // the bytes of a real
+        std::uint32_t realSize;
+        // the number of entities of dimension 0, ..., 3 (0 above the dimension of the mesh)
+        std::uint64_t nEntities[4];
+        // the number of element sets
+        std::uint64_t nLabels;
+        // the bytes of the names of the element sets
+        std::uint64_t labelBytes;
+    };
+
+    // the magic string, version and byte order mark of the binary mesh format
+    inline constexpr char binaryMeshMagic[8] = { 'M', 'I', 'T', 'O', 'M', 'E', 'S', 'H' };
+    inline constexpr std::uint32_t binaryMeshVersion = 1;
+    inline constexpr std::uint32_t binaryMeshByteOrder = 0x01020304;
+
+    // the offsets from the beginning of the file of the arrays of a binary mesh: the coordinates,
+    // the compositions of the entities of dimension 1, ..., dim, the labels, the names of the
+    // element sets, and the end of the file
+    inline std::vector<std::uint64_t> binaryMeshLayout(const binary_mesh_header_t & header)
+    {
+        auto align = [](std::uint64_t bytes) { return (bytes + 7) / 8 * 8; };
+
+        std::vector<std::uint64_t> offsets;
+        std::uint64_t offset = align(sizeof(binary_mesh_header_t));
+        // the coordinates
+        offsets.push_back(offset);
+        offset += align(header.nEntities[0] * header.dim * header.realSize);
+        // the compositions
+        for (std::uint32_t I = 1; I <= header.dim; ++I) {
+            offsets.push_back(offset);
+            offset += align(header.nEntities[I] * (I + 1) * sizeof(std::int32_t));
+        }
+        // the labels
+        offsets.push_back(offset);
+        offset += align(header.nEntities[header.dim] * sizeof(std::int32_t));
+        // the names of the element sets
+        offsets.push_back(offset);
+        offset += align(header.labelBytes);
+        // the end of the file
+        offsets.push_back(offset);
+
+        // all done
+        return offsets;
+    }
+
+    // whether {fileName} is a binary mesh file
+    inline bool isBinaryMesh(const std::string & fileName)
+    {
+        char magic[8] = {};
+        std::ifstream fileStream(fileName, std::ios::binary);
+        fileStream.read(magic, sizeof(magic));
+        return fileStream && std::memcmp(magic, binaryMeshMagic, sizeof(magic)) == 0;
+    }
+
+    // check that {header} describes a binary mesh of dimension {dim} in a file of {size} bytes
+    inline bool checkBinaryMesh(const binary_mesh_header_t & header, int dim, std::size_t size)
+    {
+        if (std::memcmp(header.magic, binaryMeshMagic, sizeof(header.magic)) != 0) {
+            std::cout << "Error: Not a binary mesh file" << std::endl;
+            return false;
+        }
+        if (header.version != binaryMeshVersion) {
+            std::cout << "Error: Unsupported binary mesh version " << header.version << std::endl;
+            return false;
+        }
+        if (header.byteOrder != binaryMeshByteOrder) {
+            std::cout << "Error: Binary mesh written with another byte order" << std::endl;
+            return false;
+        }
+        if (header.dim != std::uint32_t(dim) || header.realSize != sizeof(real)) {
+            std::cout << "Error: Binary mesh of dimension " << header.dim << " with "
+                      << header.realSize << "-byte reals, expected dimension " << dim << " with "
+                      << sizeof(real) << "-byte reals" << std::endl;
+            return false;
+        }
+        for (int I = 0; I <= dim; ++I) {
+            if (header.nEntities[I] > std::uint64_t(INT32_MAX)) {
+                std::cout << "Error: Too many entities of dimension " << I << std::endl;
+                return false;
+            }
+        }
+        if (header.nLabels > std::uint64_t(INT32_MAX) || header.labelBytes > size) {
+            std::cout << "Error: Too many element sets" << std::endl;
+            return false;
+        }
+        if (binaryMeshLayout(header).back() > size) {
+            std::cout << "Error: Truncated binary mesh file" << std::endl;
+            return false;
+        }
+
+        // all done
+        return true;
+    }
+
+    // read the names of the element sets of a binary mesh from the {header.labelBytes} bytes at
+    // {names} (each name ends with a '\0') into {labels}
+    inline bool readBinaryMeshLabels(
+        const binary_mesh_header_t & header, const char * names, std::vector<std::string> & labels)
+    {
+        labels.clear();
+        for (std::uint64_t n = 0, offset = 0; n < header.nLabels; ++n) {
+            // the name (and its '\0') must be within the names
+            std::size_t length = 0;
+            if (offset < header.labelBytes) {
+                length = strnlen(names + offset, header.labelBytes - offset);
+            }
+            if (offset + length >= header.labelBytes) {
+                std::cout << "Error: Malformed element set names" << std::endl;
+                return false;
+            }
+            labels.emplace_back(names + offset, length);
+            offset += length + 1;
+        }
+
+        // all done
+        return true;
+    }
+
+    // A file mapped in memory (read only), unmapped on destruction
+    class MappedFile {
+
+      public:
+        inline MappedFile(const std::string & fileName) : _data(nullptr), _size(0)
+        {
+            int fd = ::open(fileName.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return;
+            }
+
+            struct stat status;
+            if (::fstat(fd, &status) == 0 && status.st_size > 0) {
+                void * data = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED) {
+                    _data = static_cast<const char *>(data);
+                    _size = status.st_size;
+                    // the arrays are read front to back
+                    ::madvise(data, _size, MADV_SEQUENTIAL);
+                }
+            }
+
+            // the mapping outlives the file descriptor
+            ::close(fd);
+        }
+
+        inline ~MappedFile()
+        {
+            if (_data != nullptr) {
+                ::munmap(const_cast<char *>(_data), _size);
+            }
+        }
+
+      private:
+        // delete copy constructor
+        MappedFile(const MappedFile &) = delete;
+
+        // delete assignment operator
+        const MappedFile & operator=(const MappedFile &) = delete;
+
+      public:
+        // whether the file is mapped
+        inline bool isOpen() const { return _data != nullptr; }
+
+        // the bytes of the file
+        inline std::size_t size() const { return _size; }
+
+        // the array of type T at {offset} bytes from the beginning of the file
+        template <class T>
+        inline const T * at(std::uint64_t offset) const
+        {
+            return reinterpret_cast<const T *>(_data + offset);
+        }
+
+      private:
+        // the mapped file
+        const char * _data;
+        // the bytes of the file
+        std::size_t _size;
+    };
+
+}    // namespace mito
+
+#endif    // mito_mesh_BinaryMesh_h
+
+// end of file
@@ -0,0 +1,148 @@
+// code guard
+#if !defined(mito_mesh_CompositionTable_h)
+#define mito_mesh_CompositionTable_h
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "../mito.h"
+
+namespace mito {
+
+    // A hash table mapping the compositions of mesh entities (the sorted arrays of the N pointers
+    // to their subentities) to the entities they compose. The entries are stored in one array with
+    // open addressing (linear probing), so that an insertion costs a hash and (on average) a couple
+    // of contiguous probes, and no allocation unless the table grows. Entries are never erased; the
+    // table doubles when it is half full, and spreads the entries of each first entity over more
+    // entries when a probe runs too long (when an entity is the first of many compositions).
+    template <class S, int N, class value_t>
+    class CompositionTable {
+
+      public:
+        // the key: a composition of entities
+        using key_t = std::array<S *, N>;
+
+      private:
+        // an entry (empty if the first entity of its key is null)
+        using entry_t = std::pair<key_t, value_t>;
+
+      public:
+        // constructor
+        inline CompositionTable() : _entries(), _size(0), _spread(4) {}
+
+      public:
+        // make room for {n} entries without growing
+        inline void reserve(int n)
+        {
+            int capacity = 16;
+            while (capacity < 2 * n) {
+                capacity *= 2;
+            }
+            if (capacity > (int) _entries.size()) {
+                _rehash(capacity);
+            }
+
+            // all done
+            return;
+        }
+
+        /**
+         * @brief Finds the entry with key {key}, inserting it with value {value} if there is none
+         *
+         * @return a pair of a pointer to the value of the entry (valid until the next insertion)
+         *          and of whether the entry was inserted
+         */
+        inline std::pair<value_t *, bool> try_emplace(const key_t & key, const value_t & value)
+        {
+            // grow the table if it would be more than half full
+            if (2 * (_size + 1) > (int) _entries.size()) {
+                _rehash(std::max(16, 2 * (int) _entries.size()));
+            }
+
+            // probe the entries from the one of the hash of {key}
+            std::size_t mask = _entries.size() - 1;
+            int probes = 0;
+            for (std::size_t i = _hash(key) & mask;; i = (i + 1) & mask, ++probes) {
+                // a long run of entries: spread the compositions of each first entity over more
+                // entries and start over
+                if (probes == _maxProbes && _spread < _maxSpread) {
+                    _spread *= 2;
+                    _rehash(_entries.size());
+                    return try_emplace(key, value);
+                }
+                entry_t & entry = _entries[i];
+                // an empty entry: insert the key here
+                if (entry.first[0] == nullptr) {
+                    entry = { key, value };
+                    ++_size;
+                    return { &entry.second, true };
+                }
+                // the key is already there
+                if (entry.first == key) {
+                    return { &entry.second, false };
+                }
+            }
+        }
+
+        // the number of entries
+        inline int size() const { return _size; }
+
+        // remove all entries and release the storage
+        inline void clear()
+        {
+            std::vector<entry_t>().swap(_entries);
+            _size = 0;
+        }
+
+      private:
+        // helper function: the hash of a composition, keeping the compositions of neighboring
+        // first entities in neighboring entries: as the entities of the mesh are allocated
+        // contiguously in its arenas, and the entities composed one after the other share most of
+        // their subentities, most probes then hit entries already in cache (any other layout of
+        // the entities is still correct, only slower)
+        inline std::size_t _hash(const key_t & key) const
+        {
+            std::uint64_t h = 0;
+            for (int n = 1; n < N; ++n) {
+                h = (h ^ reinterpret_cast<std::uintptr_t>(key[n])) * 0x9E3779B97F4A7C15ull;
+                h ^= h >> 29;
+            }
+            return reinterpret_cast<std::uintptr_t>(key[0]) / sizeof(S) * _spread + h % _spread;
+        }
+
+        // helper function: move the entries to a table of {capacity} (a power of 2) entries
+        inline void _rehash(int capacity)
+        {
+            std::vector<entry_t> entries(capacity, entry_t { key_t {}, value_t {} });
+            entries.swap(_entries);
+            _size = 0;
+            for (const auto & entry : entries) {
+                if (entry.first[0] != nullptr) {
+                    try_emplace(entry.first, entry.second);
+                }
+            }
+
+            // all done
+            return;
+        }
+
+      private:
+        // the length of a probe that makes the table spread the compositions further
+        static constexpr int _maxProbes = 32;
+        // the largest number of entries over which the compositions with the same first entity are
+        // spread
+        static constexpr int _maxSpread = 1024;
+        // the entries
+        std::vector<entry_t> _entries;
+        // the number of entries
+        int _size;
+        // the number of entries over which the compositions with the same first entity are spread
+        int _spread;
+    };
+
+}    // namespace mito
+
+#endif    // mito_mesh_CompositionTable_h
+
+// end of file
@@ -2,6 +2,9 @@
 #if !defined(mito_mesh_ElementSet_h)
 #define mito_mesh_ElementSet_h
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include "Simplex.h"
 #include "VertexPointMap.h"
 
@@ -12,52 +15,85 @@ namespace mito {
     {
         // return the distance between the two points
         auto dist = pointA - pointB;
-        return sqrt(dist * dist);
+        return std::sqrt(dist * dist);
+    }
+
+    // helper function: write the vertices reached through the faces of {simplex} (each vertex as
+    // many times as it is reached) from {out} on, and return the position after them
+    template <int I>
+    const vertex_t ** _collectVertices(const Simplex<I> * simplex, const vertex_t ** out)
+    {
+        if constexpr (I == 0) {
+            *out = simplex;
+            return out + 1;
+        } else {
+            for (const auto & entity : simplex->entities()) {
+                out = _collectVertices<I - 1>(entity, out);
+            }
+            return out;
+        }
+    }
+
+    // the ids of the vertices of each of {elements} (ordered as in Simplex::getVertices, i.e. by
+    // address), one element after the other
+    template <class element_t, int D>
+    void computeElementsVertices(
+        const std::vector<element_t *> & elements, const VertexPointMap<D> & coordinatesMap,
+        std::vector<int> & vertices)
+    {
+        // the dimension and the number of vertices of the elements
+        constexpr int I = element_t::parametricDim - 1;
+        constexpr int V = element_t::parametricDim;
+
+        vertices.clear();
+        vertices.reserve(V * elements.size());
+        for (const auto & element : elements) {
+            // the vertices of the element without repeated entries (each of the (I + 1)! paths
+            // through the faces of the element reaches one vertex), in order of address
+            std::array<const vertex_t *, Factorial<I + 1>()> reached;
+            _collectVertices<I>(element, reached.data());
+            std::sort(reached.begin(), reached.end());
+            [[maybe_unused]] auto last = std::unique(reached.begin(), reached.end());
+            assert(last - reached.begin() == V);
+            // look up the id of each vertex
+            for (int v = 0; v < V; ++v) {
+                vertices.push_back(coordinatesMap.index(reached[v]));
+            }
+        }
+
+        // all done
+        return;
     }
 
     template <int D>
     void computeSimplicesVolume(
-        const std::vector<Simplex<D> *> & elements, const VertexPointMap<D> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<D> & coordinatesMap,
         std::vector<real> & volumes)
     {
         // number of vertices
         constexpr int V = D + 1;
 
         // a container to store the coordinates of each vertex in a tensor
-        static tensor_t<V> verticesTensor;
+        tensor_t<V> verticesTensor;
 
         // assert memory allocation is consistent
-        assert(volumes.size() == elements.size());
+        assert(V * volumes.size() == vertices.size());
 
         // loop on elements
-        int e = 0;
-        for (const auto & element : elements) {
-
-            // reinitialize verticesTensor for a new element
-            verticesTensor.reset();
-
-            // use a set to collect vertices without repeated entries
-            std::set<const vertex_t *> vertices;
-            element->getVertices(vertices);
-            // assert you found D+1 vertices
-            assert(V == vertices.size());
+        for (int e = 0; e < (int) volumes.size(); ++e) {
 
             // loop on vertices
-            int v = 0;
-            for (const auto & vertex : vertices) {
+            for (int v = 0; v < V; ++v) {
                 // fill up verticesTensor container
+                const auto & point = coordinatesMap[vertices[e * V + v]];
                 for (int d = 0; d < D; ++d) {
-                    verticesTensor[v * V + d] = coordinatesMap[vertex][d];
+                    verticesTensor[v * V + d] = point[d];
                 }
                 verticesTensor[v * V + D] = 1.0;
-                // update vertices counter
-                ++v;
             }
 
             // compute the volume of the e-th element
-            volumes[e] = fabs(ComputeDeterminant(verticesTensor)) / Factorial<D>();
-            // update elements counter
-            ++e;
+            volumes[e] = std::fabs(ComputeDeterminant(verticesTensor)) / Factorial<D>();
         }
 
         // all done
@@ -66,62 +102,49 @@ namespace mito {
 
     template <class element_t, int D>
     void computeElementsVolume(
-        const std::vector<element_t *> & elements, const VertexPointMap<D> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<D> & coordinatesMap,
         std::vector<real> & volumes);
 
     template <>
     void computeElementsVolume<triangle_t, 2>(
-        const std::vector<triangle_t *> & elements, const VertexPointMap<2> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<2> & coordinatesMap,
         std::vector<real> & volumes)
     {
-        return computeSimplicesVolume<2>(elements, coordinatesMap, volumes);
+        return computeSimplicesVolume<2>(vertices, coordinatesMap, volumes);
     }
 
     template <>
     void computeElementsVolume<tetrahedron_t, 3>(
-        const std::vector<tetrahedron_t *> & elements, const VertexPointMap<3> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<3> & coordinatesMap,
         std::vector<real> & volumes)
     {
-        return computeSimplicesVolume<3>(elements, coordinatesMap, volumes);
+        return computeSimplicesVolume<3>(vertices, coordinatesMap, volumes);
     }
 
     template <>
     void computeElementsVolume<segment_t, 1>(
-        const std::vector<segment_t *> & elements, const VertexPointMap<1> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<1> & coordinatesMap,
         std::vector<real> & volumes)
     {
-        return computeSimplicesVolume<1>(elements, coordinatesMap, volumes);
+        return computeSimplicesVolume<1>(vertices, coordinatesMap, volumes);
     }
 
     template <int D>
     void computeSegmentsLength(
-        const std::vector<segment_t *> & elements, const VertexPointMap<D> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<D> & coordinatesMap,
         std::vector<real> & length)
     {
         // number of vertices
         constexpr int V = 2;
 
         // assert memory allocation is consistent
-        assert(length.size() == elements.size());
+        assert(V * length.size() == vertices.size());
 
         // loop on elements
-        int e = 0;
-        for (const auto & element : elements) {
-
-            // collect vertices
-            std::set<const vertex_t *> vertices_set;
-            element->getVertices(vertices_set);
-            std::vector<const vertex_t *> vertices(vertices_set.begin(), vertices_set.end());
-
-            // assert the size of vertices container is equal to the number of vertices
-            assert(vertices.size() == V);
-
+        for (int e = 0; e < (int) length.size(); ++e) {
             // store the distance between the two vertices as the element length
-            length[e] =
-                computeDistance<D>(coordinatesMap[vertices[0]], coordinatesMap[vertices[1]]);
-
-            // update elements counter
-            ++e;
+            length[e] = computeDistance<D>(
+                coordinatesMap[vertices[e * V]], coordinatesMap[vertices[e * V + 1]]);
         }
 
         // all done
@@ -130,43 +153,45 @@ namespace mito {
 
     template <>
     void computeElementsVolume<segment_t, 2>(
-        const std::vector<segment_t *> & elements, const VertexPointMap<2> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<2> & coordinatesMap,
         std::vector<real> & volumes)
     {
-        return computeSegmentsLength<2>(elements, coordinatesMap, volumes);
+        return computeSegmentsLength<2>(vertices, coordinatesMap, volumes);
     }
 
     template <>
     void computeElementsVolume<segment_t, 3>(
-        const std::vector<segment_t *> & elements, const VertexPointMap<3> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<3> & coordinatesMap,
         std::vector<real> & volumes)
     {
-        return computeSegmentsLength<3>(elements, coordinatesMap, volumes);
+        return computeSegmentsLength<3>(vertices, coordinatesMap, volumes);
     }
 
     // follows implementation by Kahan2014
     template <int D = 3>
     void computeTriangleArea(
-        const std::vector<triangle_t *> & elements, const VertexPointMap<D> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<D> & coordinatesMap,
         std::vector<real> & areas)
     {
+        // number of vertices
+        constexpr int V = 3;
+
+        // assert memory allocation is consistent
+        assert(V * areas.size() == vertices.size());
+
         // loop on elements
-        int e = 0;
-        for (const auto & element : elements) {
+        for (int e = 0; e < (int) areas.size(); ++e) {
 
-            // collect vertices
-            std::set<const vertex_t *> vertices_set;
-            element->getVertices(vertices_set);
-            std::vector<const vertex_t *> vertices(vertices_set.begin(), vertices_set.end());
+            // the coordinates of the vertices
+            const auto & point0 = coordinatesMap[vertices[e * V]];
+            const auto & point1 = coordinatesMap[vertices[e * V + 1]];
+            const auto & point2 = coordinatesMap[vertices[e * V + 2]];
 
             // compute lengths of three edges
             std::array<real, 3> edges_lengths;
-            edges_lengths[0] =
-                computeDistance<D>(coordinatesMap[vertices[0]], coordinatesMap[vertices[1]]);
-            edges_lengths[1] =
-                computeDistance<D>(coordinatesMap[vertices[0]], coordinatesMap[vertices[2]]);
-            edges_lengths[2] =
-                computeDistance<D>(coordinatesMap[vertices[1]], coordinatesMap[vertices[2]]);
+            edges_lengths[0] = computeDistance<D>(point0, point1);
+            edges_lengths[1] = computeDistance<D>(point0, point2);
+            edges_lengths[2] = computeDistance<D>(point1, point2);
 
             // sort edges lengths in ascending order
             std::sort(edges_lengths.begin(), edges_lengths.end());
@@ -180,10 +205,7 @@ namespace mito {
             real bpc = b + c;
 
             // compute area of element e
-            areas[e] = 0.25 * sqrt((a + bpc) * (c - amb) * (c + amb) * (a + bmc));
-
-            // update elements counter
-            ++e;
+            areas[e] = 0.25 * std::sqrt((a + bpc) * (c - amb) * (c + amb) * (a + bmc));
         }
 
         // all done
@@ -192,10 +214,10 @@ namespace mito {
 
     template <>
     void computeElementsVolume<triangle_t, 3>(
-        const std::vector<triangle_t *> & elements, const VertexPointMap<3> & coordinatesMap,
+        const std::vector<int> & vertices, const VertexPointMap<3> & coordinatesMap,
         std::vector<real> & volumes)
     {
-        return computeTriangleArea(elements, coordinatesMap, volumes);
+        return computeTriangleArea(vertices, coordinatesMap, volumes);
     }
 
     // QUESTION:
@@ -216,8 +238,12 @@ namespace mito {
             const std::vector<element_t *> & elements, const VertexPointMap<D> & coordinatesMap) :
             _elements(elements),
             _coordinatesMap(coordinatesMap),
+            _vertices(),
             _jacobians(elements.size(), 0.0)
         {
+            // look up the ids of the vertices of each element
+            computeElementsVertices(_elements, _coordinatesMap, _vertices);
+
             // compute the jacobians of the map from reference to current element for each element
             _computeJacobians();
         }
@@ -225,8 +251,30 @@ namespace mito {
         ElementSet(std::vector<element_t *> && elements, const VertexPointMap<D> & coordinatesMap) :
             _elements(elements),
             _coordinatesMap(coordinatesMap),
+            _vertices(),
             _jacobians(elements.size(), 0.0)
         {
+            // look up the ids of the vertices of each element
+            computeElementsVertices(_elements, _coordinatesMap, _vertices);
+
+            // compute the jacobians of the map from reference to current element for each element
+            _computeJacobians();
+        }
+
+        // constructor with the ids of the vertices of each element, one element after the other
+        // (e.g. from the topology of a mesh, which lists them in increasing order of id), which are
+        // then not looked up by address and are kept in the order given
+        ElementSet(
+            std::vector<element_t *> elements, std::vector<int> vertices,
+            const VertexPointMap<D> & coordinatesMap) :
+            _elements(std::move(elements)),
+            _coordinatesMap(coordinatesMap),
+            _vertices(std::move(vertices)),
+            _jacobians(_elements.size(), 0.0)
+        {
+            // assert there are the vertices of each element
+            assert(_vertices.size() == _elements.size() * element_t::parametricDim);
+
             // compute the jacobians of the map from reference to current element for each element
             _computeJacobians();
         }
@@ -235,6 +283,10 @@ namespace mito {
             const std::vector<element_t *> & elements,
             const VertexPointMap<D> && coordinatesMap) = delete;
 
+        ElementSet(
+            std::vector<element_t *> elements, std::vector<int> vertices,
+            const VertexPointMap<D> && coordinatesMap) = delete;
+
         ElementSet(
             std::vector<element_t *> && elements,
             const VertexPointMap<D> && coordinatesMap) = delete;
@@ -278,17 +330,27 @@ namespace mito {
         {
             return _coordinatesMap[v];
         }
+        // the coordinates of the {v}-th vertex of element {e}: the vertices of an element are
+        // ordered by address (as in getVertices) when the set is built from the elements only, and
+        // as given (e.g. by increasing id, for the topology of a mesh) when built from their ids;
+        // the two orders only agree for vertices in the same block of the vertex arena
+        inline const auto & coordinatesVertex(int e, int v) const
+        {
+            return _coordinatesMap[_vertices[e * element_t::parametricDim + v]];
+        }
 
       private:
         void _computeJacobians()
         {
             return computeElementsVolume<element_t /* element type */, D /* spatial dim*/>(
-                _elements, _coordinatesMap, _jacobians);
+                _vertices, _coordinatesMap, _jacobians);
         }
 
       private:
         const std::vector<element_t *> _elements;
         const VertexPointMap<D> & _coordinatesMap;
+        // the ids of the vertices of the elements, one element after the other
+        std::vector<int> _vertices;
         std::vector<real> _jacobians;
     };
 
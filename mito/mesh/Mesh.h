@@ -2,10 +2,16 @@
 #if !defined(mito_mesh_Mesh_h)
 #define mito_mesh_Mesh_h
 
+#include "Arena.h"
+#include "BinaryMesh.h"
+#include "CompositionTable.h"
+#include "Reordering.h"
 #include "Simplex.h"
+#include "SummitFile.h"
+#include "Topology.h"
 #include "VertexPointMap.h"
-#include <map>
 #include <fstream>
+#include <numeric>
 
 namespace mito {
 
@@ -37,17 +43,29 @@ namespace mito {
         //      entity_collection<Simplex<D>*>
         using entities_tuple_t = typename entities_tuple<>::type;
 
+        // arena_tuple<>::type expands to:
+        // tuple<Arena<Simplex<0>>, Arena<Simplex<1>>, ..., Arena<Simplex<D>>
+        template <typename = std::make_index_sequence<D + 1>>
+        struct arena_tuple;
+
+        template <size_t... I>
+        struct arena_tuple<std::index_sequence<I...>> {
+            using type = std::tuple<Arena<Simplex<int(I)>>...>;
+        };
+
+        // the arenas storing the entities of each dimension
+        using arena_tuple_t = typename arena_tuple<>::type;
+
       private:
         // typedef for a composition map of mesh entities:
         // these maps map:
         //      2 pointers to nodes into a pointer to edge,
         //      3 pointers to edges into a pointer to face, ...
-        // std::map<std::array<Simplex<0> *, 2>, Simplex<1> *>  edges composition
-        // std::map<std::array<Simplex<1> *, 3>, Simplex<2> *>  faces compositions
-        // std::map<std::array<Simplex<2> *, 4>, Simplex<3> *>  volumes compositions
+        // CompositionTable<Simplex<0>, 2, Simplex<1> *>  edges composition
+        // CompositionTable<Simplex<1>, 3, Simplex<2> *>  faces compositions
+        // CompositionTable<Simplex<2>, 4, Simplex<3> *>  volumes compositions
         template <size_t I>
-        using composition_map =
-            std::map<std::array<Simplex<int(I - 1)> *, I + 1>, Simplex<int(I)> *>;
+        using composition_map = CompositionTable<Simplex<int(I - 1)>, I + 1, Simplex<int(I)> *>;
 
         template <typename = std::make_index_sequence<D>>
         struct composition_tuple;
@@ -62,41 +80,33 @@ namespace mito {
         using composition_tuple_t = typename composition_tuple<>::type;
 
       public:
-        Mesh(std::string meshFileName) : _entities(), _compositions(), _vertexCoordinatesMap()
+        // load the mesh in file {meshFileName}, with its vertices and elements in {ordering} (the
+        // entities of a binary mesh file are in the order in which they were written)
+        Mesh(std::string meshFileName, Ordering ordering = Ordering::file) :
+            Mesh(meshFileName, _serial(), ordering)
+        {}
+
+        // load the mesh in file {meshFileName}, parsing text files with the threads of {pool}
+        Mesh(std::string meshFileName, ThreadPool & pool, Ordering ordering = Ordering::file) :
+            _arenas(),
+            _entities(),
+            _compositions(),
+            _topology(),
+            _vertexCoordinatesMap(),
+            _labels(),
+            _elementLabels(),
+            _labelOffsets(),
+            _labelElements()
         {
-            _loadMesh(meshFileName);
-        }
-
-        template <size_t I>
-        void _deleteEntities()
-        {
-            // delete entities of dimension I
-            for (auto element : std::get<I>(_entities)) {
-                delete element;
+            if (isBinaryMesh(meshFileName)) {
+                _loadBinaryMesh(meshFileName);
+            } else {
+                _loadMesh(meshFileName, pool, ordering);
             }
-
-            // all done
-            return;
         }
 
-        template <size_t... I>
-        void _deleteAllEntities(std::index_sequence<I...>)
-        {
-            // delete entities of dimension I for all I's in the index sequence
-            ((_deleteEntities<I>()), ...);
-
-            // all done
-            return;
-        }
-
-        ~Mesh()
-        {
-            // delete all entities from dimension 0 (included) to D (included)
-            _deleteAllEntities(std::make_index_sequence<D + 1> {});
-
-            // all done
-            return;
-        }
+        // the entities are destroyed (and their storage released) together with their arenas
+        ~Mesh() {}
 
       private:
         // delete default constructor
@@ -139,26 +149,168 @@ namespace mito {
         int nEntities() const
         {
             // all done
-            return std::get<I>(_entities).size();
+            return _topology.template nEntities<I>();
         }
 
-      private:
-        /**
-         * @brief Registers an entity in the composition map
-         *
-         * @tparam I dimension of the entity to insert
-         * @param entity mesh entity to be inserted
-         * @return the pair returned by the map insertion:
-         *          pair::first is an iterator pointing to either the newly inserted element or
-         * to the element with an equivalent key pair::second is true (false) if the entity was
-         * inserted (was already in the map)
-         */
+        // the entities of dimension I
         template <int I>
-        auto _registerEntityComposition(Simplex<I> & entity)
+        const auto & entities() const
+        {
+            // all done
+            return std::get<I>(_entities);
+        }
+
+        // the topology of the mesh as indices (entities are numbered in their order in entities())
+        const auto & topology() const
+        {
+            // all done
+            return _topology;
+        }
+
+        // the coordinates of the vertices (the id of a vertex is its index in the topology)
+        const auto & coordinates() const
+        {
+            // all done
+            return _vertexCoordinatesMap;
+        }
+
+        // the names of the element sets
+        const std::vector<std::string> & labels() const
+        {
+            // all done
+            return _labels;
+        }
+
+        // the element set of each element (an index in labels())
+        const std::vector<int> & elementLabels() const
+        {
+            // all done
+            return _elementLabels;
+        }
+
+        // the index in labels() of the element set named {name} (-1 if there is none)
+        int label(std::string_view name) const
         {
-            return std::get<I - 1>(_compositions)
-                .insert(std::pair<std::array<Simplex<I - 1> *, I + 1>, Simplex<I> *>(
-                    entity.entities(), &entity));
+            auto found = std::find(_labels.begin(), _labels.end(), name);
+            return found == _labels.end() ? -1 : found - _labels.begin();
+        }
+
+        // the indices of the elements of the element set {label}, in increasing order
+        std::span<const int> elementIndices(int label) const
+        {
+            assert(label >= 0 && label < int(_labels.size()));
+            return std::span<const int>(
+                _labelElements.data() + _labelOffsets[label],
+                _labelOffsets[label + 1] - _labelOffsets[label]);
+        }
+
+        // the elements of the element set {label} (e.g. to build the ElementSet of a region)
+        std::vector<Simplex<D> *> elements(int label) const
+        {
+            std::vector<Simplex<D> *> elements;
+            elements.reserve(elementIndices(label).size());
+            for (auto e : elementIndices(label)) {
+                elements.push_back(std::get<D>(_entities)[e]);
+            }
+
+            // all done
+            return elements;
+        }
+
+        // the ids of the vertices of the elements (in increasing order), one element after the
+        // other (e.g. to build the ElementSet of the mesh without looking the vertices up)
+        std::vector<int> elementsVertices() const
+        {
+            std::vector<int> vertices;
+            vertices.reserve((D + 1) * nEntities<D>());
+            for (int e = 0; e < nEntities<D>(); ++e) {
+                auto element = _topology.template vertices<D>(e);
+                vertices.insert(vertices.end(), element.begin(), element.end());
+            }
+
+            // all done
+            return vertices;
+        }
+
+        // the ids of the vertices of the elements of the element set {label}, as for elements()
+        std::vector<int> elementsVertices(int label) const
+        {
+            std::vector<int> vertices;
+            vertices.reserve((D + 1) * elementIndices(label).size());
+            for (auto e : elementIndices(label)) {
+                auto element = _topology.template vertices<D>(e);
+                vertices.insert(vertices.end(), element.begin(), element.end());
+            }
+
+            // all done
+            return vertices;
+        }
+
+        // write the mesh to {meshFileName} in the binary mesh format
+        void writeBinary(std::string meshFileName) const
+        {
+            // open mesh file
+            std::ofstream fileStream(meshFileName, std::ios::binary);
+            assert(fileStream.is_open());
+
+            // the header
+            binary_mesh_header_t header {};
+            std::memcpy(header.magic, binaryMeshMagic, sizeof(header.magic));
+            header.version = binaryMeshVersion;
+            header.byteOrder = binaryMeshByteOrder;
+            header.dim = D;
+            header.realSize = sizeof(real);
+            _countEntities(header, std::make_index_sequence<D + 1> {});
+            header.nLabels = _labels.size();
+            for (const auto & label : _labels) {
+                header.labelBytes += label.size() + 1;
+            }
+            auto offsets = binaryMeshLayout(header);
+
+            // write {bytes} bytes at {data} at {offset} bytes from the beginning of the file
+            auto write = [&fileStream](std::uint64_t offset, const void * data, std::size_t bytes) {
+                while (std::uint64_t(fileStream.tellp()) < offset) {
+                    fileStream.put(0);
+                }
+                fileStream.write(static_cast<const char *>(data), bytes);
+            };
+            write(0, &header, sizeof(header));
+
+            // the coordinates
+            std::vector<real> coordinates;
+            coordinates.reserve(D * nEntities<0>());
+            for (const auto & point : _vertexCoordinatesMap.points()) {
+                for (int d = 0; d < D; ++d) {
+                    coordinates.push_back(point[d]);
+                }
+            }
+            write(offsets[0], coordinates.data(), coordinates.size() * sizeof(real));
+
+            // the compositions
+            _writeCompositions(write, offsets, std::make_index_sequence<D> {});
+
+            // the labels
+            static_assert(sizeof(int) == sizeof(std::int32_t));
+            write(offsets[D + 1], _elementLabels.data(), _elementLabels.size() * sizeof(int));
+
+            // the names of the element sets
+            std::uint64_t offset = offsets[D + 2];
+            for (const auto & label : _labels) {
+                write(offset, label.c_str(), label.size() + 1);
+                offset += label.size() + 1;
+            }
+            write(offsets[D + 3], nullptr, 0);
+
+            // all done
+            return;
+        }
+
+      private:
+        // a pool running the loops on the calling thread only
+        static ThreadPool & _serial()
+        {
+            static ThreadPool pool(1);
+            return pool;
         }
 
         /**
@@ -173,17 +325,17 @@ namespace mito {
         template <int I>
         Simplex<I> * _addUniqueEntity(std::array<Simplex<I - 1> *, I + 1> && composition)
         {
-            // instantiate new entity with this composition
-            Simplex<I> * entity = new Simplex<I>(std::move(composition));
-            // look up the new entity with its composition and register it if it does not exist yet
-            auto ret = _registerEntityComposition(*entity);
+            // sort the composition as the simplex would (by the address of the entities), so that
+            // equivalent compositions are found equal before instantiating any entity
+            std::sort(composition.begin(), composition.end());
+            // look up the composition and register it if it does not exist yet
+            auto ret = std::get<I - 1>(_compositions).try_emplace(composition, nullptr);
             // if the entity did not exist
             if (ret.second == true) {
+                // instantiate the new entity with this composition in the arena of dimension I
+                *ret.first = std::get<I>(_arenas).create(std::move(composition));
                 // add the entity as a new one
-                _addEntity(entity);
-            } else {
-                // delete the new entity (it was just a repeated entry)
-                delete entity;
+                _addEntity(*ret.first);
             }
 
             // if I == D then ret.second == true, that is there shall be no repetitions of the
@@ -191,7 +343,7 @@ namespace mito {
             assert((I != D) || ret.second);
 
             // return a pointer to the newly added entity
-            return ret.first->second;
+            return *ret.first;
         }
 
         template <int I>
@@ -206,12 +358,14 @@ namespace mito {
             return;
         }
 
-        void _addVertex(point_t<D> && point)
+        void _addVertex(const point_t<D> & point)
         {
             // instantiate new vertex
-            vertex_t * vertex = new vertex_t();
-            // associate the new vertex to the new point
-            _vertexCoordinatesMap.insert(*vertex, std::move(point));
+            vertex_t * vertex = std::get<0>(_arenas).create();
+            // associate the new vertex to (a copy of) the new point
+            [[maybe_unused]] int id = _vertexCoordinatesMap.insert(*vertex, point);
+            // assert the id of the vertex is its index in the topology
+            assert(id == std::get<0>(_arenas).size() - 1);
             // add the newly created vertex
             _addEntity(vertex);
 
@@ -219,121 +373,276 @@ namespace mito {
             return;
         }
 
-        template <int I>
-        auto _getEntity(int n)
-        {
-            return std::get<I>(_entities)[n];
-        }
-
-        void _readTriangle(std::ifstream & fileStream)
+        void _addTriangle(std::span<const int> vertices, std::string_view label)
         {
-            int index0 = 0;
-            fileStream >> index0;
-            --index0;
-
-            int index1 = 0;
-            fileStream >> index1;
-            --index1;
-
-            int index2 = 0;
-            fileStream >> index2;
-            --index2;
-
-            vertex_t * vertex0 = _getEntity<0>(index0);
-            vertex_t * vertex1 = _getEntity<0>(index1);
-            vertex_t * vertex2 = _getEntity<0>(index2);
+            vertex_t * vertex0 = std::get<0>(_entities)[vertices[0]];
+            vertex_t * vertex1 = std::get<0>(_entities)[vertices[1]];
+            vertex_t * vertex2 = std::get<0>(_entities)[vertices[2]];
 
             segment_t * segment0 = _addUniqueEntity<1>({ vertex0, vertex1 });
             segment_t * segment1 = _addUniqueEntity<1>({ vertex1, vertex2 });
             segment_t * segment2 = _addUniqueEntity<1>({ vertex2, vertex0 });
 
             // QUESTION: Can the label be more than one?
-            // read label for element
-            // TOFIX: Ignored for now
-            std::string element_set_id;
-            fileStream >> element_set_id;
-
             _addUniqueEntity<2>({ segment0, segment1, segment2 });
+            _addElementLabel(label);
+
+            // all done
+            return;
+        }
+
+        void _addTetrahedron(std::span<const int> vertices, std::string_view label)
+        {
+            vertex_t * vertex0 = std::get<0>(_entities)[vertices[0]];
+            vertex_t * vertex1 = std::get<0>(_entities)[vertices[1]];
+            vertex_t * vertex2 = std::get<0>(_entities)[vertices[2]];
+            vertex_t * vertex3 = std::get<0>(_entities)[vertices[3]];
+
+            // the six edges
+            segment_t * segment01 = _addUniqueEntity<1>({ vertex0, vertex1 });
+            segment_t * segment02 = _addUniqueEntity<1>({ vertex0, vertex2 });
+            segment_t * segment03 = _addUniqueEntity<1>({ vertex0, vertex3 });
+            segment_t * segment12 = _addUniqueEntity<1>({ vertex1, vertex2 });
+            segment_t * segment13 = _addUniqueEntity<1>({ vertex1, vertex3 });
+            segment_t * segment23 = _addUniqueEntity<1>({ vertex2, vertex3 });
+
+            // the four faces (face {i} is opposite to vertex {i})
+            triangle_t * face0 = _addUniqueEntity<2>({ segment12, segment23, segment13 });
+            triangle_t * face1 = _addUniqueEntity<2>({ segment02, segment23, segment03 });
+            triangle_t * face2 = _addUniqueEntity<2>({ segment01, segment13, segment03 });
+            triangle_t * face3 = _addUniqueEntity<2>({ segment01, segment12, segment02 });
+
+            _addUniqueEntity<3>({ face0, face1, face2, face3 });
+            _addElementLabel(label);
 
             // all done
             return;
         }
 
-        void _readVertices(std::ifstream & fileStream, int N_vertices)
+        void _addVertices(const SummitFile<D> & file, const std::vector<int> & vertexOrder)
         {
             // fill in vertices
-            for (int n = 0; n < N_vertices; ++n) {
+            for (auto n : vertexOrder) {
                 // instantiate new point
                 point_t<D> point;
                 for (int d = 0; d < D; ++d) {
-                    // read point coordinates
-                    fileStream >> point[d];
+                    point[d] = file.coordinates(n)[d];
+                }
+                _addVertex(point);
+            }
+
+            // all done
+            return;
+        }
+
+        void _addElements(
+            const SummitFile<D> & file, const std::vector<int> & elementOrder,
+            const std::vector<int> & vertexIndex)
+        {
+            for (auto e : elementOrder) {
+                // the indices of the vertices of the element in the mesh
+                std::array<int, SummitFile<D>::V> vertices;
+                std::span<const int> fileVertices = file.vertices(e);
+                for (int v = 0; v < int(fileVertices.size()); ++v) {
+                    vertices[v] = vertexIndex[fileVertices[v]];
+                }
+                std::span<const int> elementVertices(vertices.data(), fileVertices.size());
+                // the elements are triangles in 2D and tetrahedra in 3D
+                if constexpr (D == 2) {
+                    if (file.type(e) == 3) {
+                        _addTriangle(elementVertices, file.label(e));
+                        continue;
+                    }
+                } else if constexpr (D == 3) {
+                    if (file.type(e) == 4) {
+                        _addTetrahedron(elementVertices, file.label(e));
+                        continue;
+                    }
                 }
-                _addVertex(std::move(point));
+                std::cout << "Error: Unknown element type" << std::endl;
             }
-            // _vertexCoordinatesMap.print();
 
             // all done
             return;
         }
 
-        void _readElements(std::ifstream & fileStream, int N_elements)
+        void _addElementLabel(std::string_view label)
         {
-            for (int i = 0; i < N_elements; ++i) {
-                int element_type = 0;
-                fileStream >> element_type;
+            // the index of the element set named {label}, registering it if it is new
+            auto found = std::find(_labels.begin(), _labels.end(), label);
+            if (found == _labels.end()) {
+                found = _labels.insert(_labels.end(), std::string(label));
+            }
+            _elementLabels.push_back(found - _labels.begin());
 
-                if (element_type == 3) {
-                    _readTriangle(fileStream);
-                } else {
-                    std::cout << "Error: Unknown element type" << std::endl;
+            // all done
+            return;
+        }
+
+        void _indexLabels()
+        {
+            // the elements of each element set, one set after the other (a counting sort of the
+            // elements by label, so that the elements of a set stay in increasing order)
+            _labelOffsets.assign(_labels.size() + 1, 0);
+            for (auto label : _elementLabels) {
+                ++_labelOffsets[label + 1];
+            }
+            for (int n = 0; n < int(_labels.size()); ++n) {
+                _labelOffsets[n + 1] += _labelOffsets[n];
+            }
+            _labelElements.resize(_elementLabels.size());
+            std::vector<int> position(_labelOffsets.begin(), _labelOffsets.end() - 1);
+            for (int e = 0; e < int(_elementLabels.size()); ++e) {
+                _labelElements[position[_elementLabels[e]]++] = e;
+            }
+
+            // all done
+            return;
+        }
+
+        template <int I>
+        void _addToTopology()
+        {
+            // add the entities of dimension I with the indices of their entities of dimension I - 1
+            // (the index of an entity is its position in its arena, i.e. in the entities of its
+            // dimension)
+            _topology.template reserve<I>(std::get<I>(_entities).size());
+            for (const auto & entity : std::get<I>(_entities)) {
+                std::array<typename Topology<D>::index_type, I + 1> composition;
+                for (int k = 0; k < I + 1; ++k) {
+                    composition[k] = std::get<I - 1>(_arenas).index(entity->entities()[k]);
                 }
+                _topology.template addEntity<I>(composition);
             }
 
             // all done
             return;
         }
 
-        void _loadMesh(std::string meshFileName)
+        template <size_t... I>
+        void _buildTopology(std::index_sequence<I...>)
         {
-            std::cout << "Loading mesh..." << std::endl;
+            // the vertices, then the entities of dimension 1, ..., D
+            _topology.setVertices(std::get<0>(_entities).size());
+            ((_addToTopology<I + 1>()), ...);
+            _topology.finalize();
 
-            // open mesh file
-            std::ifstream fileStream;
-            fileStream.open(meshFileName);
-            assert(fileStream.is_open());
+            // all done
+            return;
+        }
 
-            // read dimension of physical space
-            int dim = 0;
-            fileStream >> dim;
+        template <size_t... I>
+        void _clearCompositions(std::index_sequence<I...>)
+        {
+            // release the composition maps of all dimensions
+            ((std::get<I>(_compositions).clear()), ...);
+
+            // all done
+            return;
+        }
+
+        static void _order(
+            const SummitFile<D> & file, Ordering ordering, std::vector<int> & vertexOrder,
+            std::vector<int> & elementOrder)
+        {
+            // the order of the file
+            if (ordering == Ordering::file) {
+                vertexOrder.resize(file.nVertices());
+                std::iota(vertexOrder.begin(), vertexOrder.end(), 0);
+                elementOrder.resize(file.nElements());
+                std::iota(elementOrder.begin(), elementOrder.end(), 0);
+                return;
+            }
+
+            // the elements along a Hilbert curve through their centroids
+            elementOrder = hilbertOrder<D>(file.nElements(), [&file](int e) {
+                std::array<real, D> centroid {};
+                for (auto v : file.vertices(e)) {
+                    for (int d = 0; d < D; ++d) {
+                        centroid[d] += file.coordinates(v)[d];
+                    }
+                }
+                for (int d = 0; d < D; ++d) {
+                    centroid[d] /= std::max(int(file.vertices(e).size()), 1);
+                }
+                return centroid;
+            });
+
+            // the vertices in the order in which the elements reach them
+            vertexOrder = firstTouchOrder(
+                file.nVertices(), elementOrder, [&file](int e) { return file.vertices(e); });
 
-            // assert this mesh object is of same dimension of the mesh being read
-            assert(int(D) == dim);
+            // all done
+            return;
+        }
+
+        void _loadMesh(std::string meshFileName, ThreadPool & pool, Ordering ordering)
+        {
+            std::cout << "Loading mesh..." << std::endl;
+
+            // read and parse mesh file
+            SummitFile<D> file(meshFileName, pool);
+            assert(file.good());
 
-            // read number of vertices
-            int N_vertices = 0;
-            fileStream >> N_vertices;
             // reserve space for vertices
+            int N_vertices = file.nVertices();
             std::get<0>(_entities).reserve(N_vertices);
+            std::get<0>(_arenas).reserve(N_vertices);
+            _vertexCoordinatesMap.reserve(N_vertices);
 
-            // read number of elements
-            int N_elements = 0;
-            fileStream >> N_elements;
             // reserve space for elements
+            int N_elements = file.nElements();
             std::get<D>(_entities).reserve(N_elements);
+            std::get<D>(_arenas).reserve(N_elements);
+            // reserve space for the edges of a triangulation, which by Euler's formula has
+            // N_vertices + N_elements - 1 edges (plus one per hole in the domain)
+            if constexpr (D == 2) {
+                std::get<1>(_entities).reserve(N_vertices + N_elements);
+                std::get<1>(_arenas).reserve(N_vertices + N_elements);
+                std::get<0>(_compositions).reserve(N_vertices + N_elements);
+            }
+            // reserve space for the faces and edges of a tetrahedral mesh, which (as each face is
+            // shared by two tetrahedra, and by Euler's formula) has about 2 N_elements faces and
+            // N_vertices + N_elements edges, plus about half a face and half an edge per boundary
+            // face (for which the arenas will grow)
+            if constexpr (D == 3) {
+                std::get<2>(_entities).reserve(2 * N_elements);
+                std::get<2>(_arenas).reserve(2 * N_elements);
+                std::get<1>(_compositions).reserve(2 * N_elements);
+                std::get<1>(_entities).reserve(N_vertices + N_elements);
+                std::get<1>(_arenas).reserve(N_vertices + N_elements);
+                std::get<0>(_compositions).reserve(N_vertices + N_elements);
+            }
+            std::get<D - 1>(_compositions).reserve(N_elements);
+
+            // the order of the vertices and of the elements in the mesh, and the index in the mesh
+            // of each vertex of the file
+            std::vector<int> vertexOrder;
+            std::vector<int> elementOrder;
+            _order(file, ordering, vertexOrder, elementOrder);
+            std::vector<int> vertexIndex(N_vertices);
+            for (int n = 0; n < N_vertices; ++n) {
+                vertexIndex[vertexOrder[n]] = n;
+            }
 
-            // read number of element sets
-            int N_element_sets = 0;
-            fileStream >> N_element_sets;
+            // add the vertices
+            _addVertices(file, vertexOrder);
 
-            // QUESTION: Not sure that we need this...
-            assert(N_element_sets == 1);
+            // add the elements
+            _addElements(file, elementOrder, vertexIndex);
 
-            // read the vertices
-            _readVertices(fileStream, N_vertices);
+            // sanity check: the elements are in as many element sets as the header says
+            if (int(_labels.size()) != file.nElementSets()) {
+                std::cout << "Error: Found " << _labels.size() << " element sets, expected "
+                          << file.nElementSets() << std::endl;
+                assert(false);
+            }
+
+            // index the elements by element set
+            _indexLabels();
 
-            // read the elements
-            _readElements(fileStream, N_elements);
+            // build the topology of the mesh as indices
+            _buildTopology(std::make_index_sequence<D> {});
 
             // sanity check: the number of vertices in the map is N_vertices
             assert(nEntities<0>() == N_vertices);
@@ -344,23 +653,185 @@ namespace mito {
             // sanity check: run sanity check for all mesh entities in cascade
             assert(sanityCheck());
 
-            // finalize file stream
-            fileStream.close();
+            // the compositions are only needed to find repeated entities while reading the mesh
+            _clearCompositions(std::make_index_sequence<D> {});
+
+            // all done
+            return;
+        }
+
+        template <int I>
+        void _readBinaryEntities(const MappedFile & file, std::uint64_t offset, int N)
+        {
+            // the compositions of the entities of dimension I, read in place
+            const std::int32_t * compositions = file.at<std::int32_t>(offset);
+
+            // reserve space for the entities (in one block of their arena)
+            std::get<I>(_entities).reserve(N);
+            std::get<I>(_arenas).reserve(N);
+
+            // instantiate the entities (there are no repeated entities to look for)
+            const auto & subentities = std::get<I - 1>(_entities);
+            for (int n = 0; n < N; ++n) {
+                std::array<Simplex<I - 1> *, I + 1> composition;
+                for (int k = 0; k < I + 1; ++k) {
+                    std::int32_t index = compositions[(I + 1) * n + k];
+                    if (index < 0 || index >= int(subentities.size())) {
+                        std::cout << "Error: Entity index out of range" << std::endl;
+                        assert(false);
+                        return;
+                    }
+                    composition[k] = subentities[index];
+                }
+                _addEntity(std::get<I>(_arenas).create(std::move(composition)));
+            }
+
+            // all done
+            return;
+        }
+
+        template <size_t... I>
+        void _readBinaryEntities(
+            const MappedFile & file, const binary_mesh_header_t & header,
+            const std::vector<std::uint64_t> & offsets, std::index_sequence<I...>)
+        {
+            // the entities of dimension 1, ..., D
+            ((_readBinaryEntities<I + 1>(file, offsets[I + 1], header.nEntities[I + 1])), ...);
+
+            // all done
+            return;
+        }
+
+        template <size_t... I>
+        void _countEntities(binary_mesh_header_t & header, std::index_sequence<I...>) const
+        {
+            ((header.nEntities[I] = nEntities<I>()), ...);
+
+            // all done
+            return;
+        }
+
+        template <class writer_t, size_t... I>
+        void _writeCompositions(
+            writer_t & write, const std::vector<std::uint64_t> & offsets,
+            std::index_sequence<I...>) const
+        {
+            // the compositions of the entities of dimension 1, ..., D
+            ((write(
+                 offsets[I + 1], _topology.template compositions<I + 1>().data(),
+                 _topology.template compositions<I + 1>().size_bytes())),
+             ...);
+
+            // all done
+            return;
+        }
+
+        void _loadBinaryMesh(std::string meshFileName)
+        {
+            std::cout << "Loading binary mesh..." << std::endl;
+
+            // map mesh file
+            MappedFile file(meshFileName);
+            assert(file.isOpen());
+
+            // read and check the header
+            binary_mesh_header_t header;
+            if (file.size() < sizeof(header)) {
+                std::cout << "Error: Truncated binary mesh file" << std::endl;
+                assert(false);
+                return;
+            }
+            std::memcpy(&header, file.at<char>(0), sizeof(header));
+            if (!checkBinaryMesh(header, D, file.size())) {
+                assert(false);
+                return;
+            }
+            auto offsets = binaryMeshLayout(header);
+
+            // read the vertices, with the coordinates read in place
+            int N_vertices = header.nEntities[0];
+            std::get<0>(_entities).reserve(N_vertices);
+            std::get<0>(_arenas).reserve(N_vertices);
+            _vertexCoordinatesMap.reserve(N_vertices);
+            const real * coordinates = file.at<real>(offsets[0]);
+            for (int n = 0; n < N_vertices; ++n) {
+                point_t<D> point;
+                for (int d = 0; d < D; ++d) {
+                    point[d] = coordinates[D * n + d];
+                }
+                _addVertex(point);
+            }
+
+            // read the edges, ..., the elements
+            _readBinaryEntities(file, header, offsets, std::make_index_sequence<D> {});
+
+            // build the topology of the mesh as indices
+            _buildTopology(std::make_index_sequence<D> {});
+
+            // read the names of the element sets
+            if (!readBinaryMeshLabels(header, file.at<char>(offsets[D + 2]), _labels)) {
+                assert(false);
+                return;
+            }
+
+            // read the labels of the elements
+            const std::int32_t * labels = file.at<std::int32_t>(offsets[D + 1]);
+            _elementLabels.assign(labels, labels + nEntities<D>());
+            for (auto label : _elementLabels) {
+                if (label < 0 || label >= int(_labels.size())) {
+                    std::cout << "Error: Element set index out of range" << std::endl;
+                    assert(false);
+                    return;
+                }
+            }
+
+            // index the elements by element set
+            _indexLabels();
+
+            // sanity check: run sanity check for all mesh entities in cascade
+            assert(sanityCheck());
 
             // all done
             return;
         }
 
       private:
+        // D+1 arenas storing the d dimensional entities with d = 0, ..., D
+        arena_tuple_t _arenas;
         // container to store D+1 containers of d dimensional entities with d = 0, ..., D
         entities_tuple_t _entities;
         // container to store D maps with the composition of i-dimensional entities in terms
         // of arrays of (i-1)-dimensional entities
         composition_tuple_t _compositions;
+        // the topology of the mesh as indices
+        Topology<D> _topology;
         // a map between the vertices addresses and a physical point in D-dimensional space
         VertexPointMap<D> _vertexCoordinatesMap;
+        // the names of the element sets
+        std::vector<std::string> _labels;
+        // the element set of each element
+        std::vector<int> _elementLabels;
+        // the elements of each element set (those of set n in _labelElements from
+        // _labelOffsets[n] to _labelOffsets[n + 1])
+        std::vector<int> _labelOffsets;
+        std::vector<int> _labelElements;
     };
 
+    // convert the .summit mesh file {summitFileName} to the binary mesh file {binaryFileName}, with
+    // its vertices and elements in {ordering}
+    template <int D>
+    void convertMesh(
+        std::string summitFileName, std::string binaryFileName,
+        Ordering ordering = Ordering::file)
+    {
+        // load the mesh and write it
+        Mesh<D> mesh(summitFileName, ordering);
+        mesh.writeBinary(binaryFileName);
+
+        // all done
+        return;
+    }
+
 }    // namespace mito
 
 #endif    // mito_mesh_Mesh_h
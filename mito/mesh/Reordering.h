@@ -0,0 +1,146 @@
+// code guard
+#if !defined(mito_mesh_Reordering_h)
+#define mito_mesh_Reordering_h
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "../mito.h"
+
+namespace mito {
+
+    // The orderings of the vertices and of the elements of a mesh read from a .summit file
+    enum class Ordering {
+        // the order of the file
+        file,
+        // the elements along a Hilbert curve through their centroids, and the vertices in the order
+        // in which these elements reach them, so that neighboring elements (and their vertices)
+        // are mostly close in memory
+        hilbert
+    };
+
+    // the index along the Hilbert curve of the D-dimensional cube of side 2^bits of the point of
+    // integer coordinates {x} (J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707,
+    // 2004: the coordinates are transposed in place into the bits of the index)
+    template <int D>
+    inline std::uint64_t hilbertIndex(std::array<std::uint32_t, D> x, int bits)
+    {
+        // undo the excess work of the inverse transform (without branches on the bits, which are
+        // as good as random)
+        for (std::uint32_t q = std::uint32_t(1) << (bits - 1); q > 1; q >>= 1) {
+            std::uint32_t p = q - 1;
+            for (int i = 0; i < D; ++i) {
+                // all ones if bit q of x[i] is set
+                std::uint32_t set = std::uint32_t(0) - std::uint32_t((x[i] & q) != 0);
+                // invert the low bits of x[0] if the bit is set, exchange them with those of x[i]
+                // otherwise
+                std::uint32_t t = (x[0] ^ x[i]) & p & ~set;
+                x[0] ^= (p & set) ^ t;
+                x[i] ^= t;
+            }
+        }
+
+        // Gray encode
+        for (int i = 1; i < D; ++i) {
+            x[i] ^= x[i - 1];
+        }
+        std::uint32_t t = 0;
+        for (std::uint32_t q = std::uint32_t(1) << (bits - 1); q > 1; q >>= 1) {
+            t ^= (q - 1) & (std::uint32_t(0) - std::uint32_t((x[D - 1] & q) != 0));
+        }
+        for (int i = 0; i < D; ++i) {
+            x[i] ^= t;
+        }
+
+        // interleave the bits of the transposed coordinates, most significant first
+        std::uint64_t index = 0;
+        for (int b = bits - 1; b >= 0; --b) {
+            for (int i = 0; i < D; ++i) {
+                index = (index << 1) | ((x[i] >> b) & 1);
+            }
+        }
+
+        // all done
+        return index;
+    }
+
+    // the order of the {N} points {point(0)}, ..., {point(N - 1)} (each an array of D reals)
+    // along a Hilbert curve through their bounding box (the index of the n-th point in the order)
+    template <int D, class pointsT>
+    inline std::vector<int> hilbertOrder(int N, const pointsT & point)
+    {
+        // the bounding box of the points
+        std::array<real, D> lower;
+        std::array<real, D> upper;
+        lower.fill(std::numeric_limits<real>::max());
+        upper.fill(std::numeric_limits<real>::lowest());
+        for (int n = 0; n < N; ++n) {
+            auto x = point(n);
+            for (int d = 0; d < D; ++d) {
+                lower[d] = std::min(lower[d], x[d]);
+                upper[d] = std::max(upper[d], x[d]);
+            }
+        }
+
+        // the points on a grid of side 2^bits over the bounding box (as many bits as fit in the
+        // index), with their index along the curve
+        constexpr int bits = std::min(63 / D, 16);
+        constexpr real side = real((std::uint32_t(1) << bits) - 1);
+        std::vector<std::pair<std::uint64_t, int>> indices(N);
+        for (int n = 0; n < N; ++n) {
+            auto x = point(n);
+            std::array<std::uint32_t, D> cell;
+            for (int d = 0; d < D; ++d) {
+                real extent = upper[d] - lower[d];
+                cell[d] = extent > 0.0 ? std::uint32_t((x[d] - lower[d]) / extent * side) : 0;
+            }
+            indices[n] = { hilbertIndex<D>(cell, bits), n };
+        }
+
+        // sort the points along the curve (ties in their original order)
+        std::sort(indices.begin(), indices.end());
+        std::vector<int> order(N);
+        for (int n = 0; n < N; ++n) {
+            order[n] = indices[n].second;
+        }
+
+        // all done
+        return order;
+    }
+
+    // the order in which the elements {elementOrder[0]}, {elementOrder[1]}, ... first reach the
+    // {N} vertices, the vertices of element {e} being {vertices(e)} (the vertices of no element
+    // last, in their original order)
+    template <class verticesT>
+    inline std::vector<int> firstTouchOrder(
+        int N, const std::vector<int> & elementOrder, const verticesT & vertices)
+    {
+        std::vector<int> order;
+        order.reserve(N);
+        std::vector<char> reached(N, false);
+        for (auto e : elementOrder) {
+            for (auto v : vertices(e)) {
+                if (!reached[v]) {
+                    reached[v] = true;
+                    order.push_back(v);
+                }
+            }
+        }
+        for (int v = 0; v < N; ++v) {
+            if (!reached[v]) {
+                order.push_back(v);
+            }
+        }
+
+        // all done
+        return order;
+    }
+
+}    // namespace mito
+
+#endif    // mito_mesh_Reordering_h
+
+// end of file
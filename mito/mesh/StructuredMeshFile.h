@@ -0,0 +1,141 @@
+// code guard
+#if !defined(mito_mesh_StructuredMeshFile_h)
+#define mito_mesh_StructuredMeshFile_h
+
+#include <cassert>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "../mito.h"
+
+namespace mito {
+
+    // the element set of the triangle with its centroid at a point
+    using structured_mesh_label_t = std::function<std::string(const point_t<2> &)>;
+
+    // write the same triangulation of the unit square with n x n cells to {fileName}, in the
+    // .summit format read by Mesh (1-based vertex indices), with the vertices randomly numbered and
+    // the elements in random order if {shuffle} (as left by a mesh generator with no regard for
+    // locality), and each triangle in the element set {label(centroid)} (all in set "1" if no
+    // {label} is given)
+    inline void writeStructuredMesh(
+        const std::string & fileName, int n, bool shuffle = false,
+        const structured_mesh_label_t & label = {})
+    {
+        std::ofstream fileStream(fileName);
+        assert(fileStream.is_open());
+        // the coordinates are written exactly
+        fileStream.precision(std::numeric_limits<real>::max_digits10);
+
+        // the number of each vertex (j * (n + 1) + i + 1 for vertex (i, j) unless shuffled) and the
+        // order of the cells
+        std::vector<int> vertex((n + 1) * (n + 1));
+        std::iota(vertex.begin(), vertex.end(), 1);
+        std::vector<int> cells(n * n);
+        std::iota(cells.begin(), cells.end(), 0);
+        if (shuffle) {
+            std::mt19937 generator(42);
+            std::shuffle(vertex.begin(), vertex.end(), generator);
+            std::shuffle(cells.begin(), cells.end(), generator);
+        }
+
+        // the element set of the two triangles of each cell, in the order of the cells
+        std::vector<std::string> labels(2 * n * n, "1");
+        if (label) {
+            for (int c = 0; c < n * n; ++c) {
+                int i = cells[c] % n;
+                int j = cells[c] / n;
+                labels[2 * c] = label({ real(3 * i + 2) / (3 * n), real(3 * j + 1) / (3 * n) });
+                labels[2 * c + 1] = label({ real(3 * i + 1) / (3 * n), real(3 * j + 2) / (3 * n) });
+            }
+        }
+
+        // dimension, number of vertices, number of elements, number of element sets
+        fileStream << 2 << "\n"
+                   << (n + 1) * (n + 1) << " " << 2 * n * n << " "
+                   << std::set<std::string>(labels.begin(), labels.end()).size() << "\n";
+
+        // the vertices, in the order of their number
+        std::vector<int> vertices(vertex.size());
+        for (int v = 0; v < int(vertex.size()); ++v) {
+            vertices[vertex[v] - 1] = v;
+        }
+        for (auto v : vertices) {
+            fileStream << real(v % (n + 1)) / n << " " << real(v / (n + 1)) / n << "\n";
+        }
+
+        // the triangles (element type 3), with their element set label
+        for (int c = 0; c < n * n; ++c) {
+            int i = cells[c] % n;
+            int j = cells[c] / n;
+            int v0 = vertex[j * (n + 1) + i];
+            int v1 = vertex[j * (n + 1) + i + 1];
+            int v2 = vertex[(j + 1) * (n + 1) + i + 1];
+            int v3 = vertex[(j + 1) * (n + 1) + i];
+            fileStream << "3 " << v0 << " " << v1 << " " << v2 << " " << labels[2 * c] << "\n";
+            fileStream << "3 " << v0 << " " << v2 << " " << v3 << " " << labels[2 * c + 1] << "\n";
+        }
+
+        // all done
+        return;
+    }
+
+    // write the unit cube with n x n x n cells, each cut in six tetrahedra around its diagonal, to
+    // {fileName}, in the .summit format read by Mesh (one element set, 1-based vertex indices; the
+    // vertices of each tetrahedron on a monotone path from the lowest to the highest corner of its
+    // cell, so that the faces of the cells are cut the same way on both sides)
+    inline void writeStructuredTetMesh(const std::string & fileName, int n)
+    {
+        std::ofstream fileStream(fileName);
+        assert(fileStream.is_open());
+        // the coordinates are written exactly
+        fileStream.precision(std::numeric_limits<real>::max_digits10);
+
+        // dimension, number of vertices, number of elements, number of element sets
+        fileStream << 3 << "\n"
+                   << (n + 1) * (n + 1) * (n + 1) << " " << 6 * n * n * n << " " << 1 << "\n";
+
+        // the vertices
+        auto vertex = [n](int i, int j, int k) { return (k * (n + 1) + j) * (n + 1) + i + 1; };
+        for (int k = 0; k <= n; ++k) {
+            for (int j = 0; j <= n; ++j) {
+                for (int i = 0; i <= n; ++i) {
+                    fileStream << real(i) / n << " " << real(j) / n << " " << real(k) / n << "\n";
+                }
+            }
+        }
+
+        // the tetrahedra (element type 4), one per order of the three axes, with their element
+        // set label
+        const int orders[6][3] = { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 },
+                                   { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } };
+        for (int k = 0; k < n; ++k) {
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < n; ++i) {
+                    for (const auto & order : orders) {
+                        int corner[3] = { i, j, k };
+                        fileStream << "4 " << vertex(corner[0], corner[1], corner[2]);
+                        for (int axis : order) {
+                            ++corner[axis];
+                            fileStream << " " << vertex(corner[0], corner[1], corner[2]);
+                        }
+                        fileStream << " 1\n";
+                    }
+                }
+            }
+        }
+
+        // all done
+        return;
+    }
+
+}    // namespace mito
+
+#endif    // mito_mesh_StructuredMeshFile_h
+
+// end of file
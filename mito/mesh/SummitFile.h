@@ -0,0 +1,305 @@
+// code guard
+#if !defined(mito_mesh_SummitFile_h)
+#define mito_mesh_SummitFile_h
+
+#include <charconv>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../mito.h"
+#include "../parallel/ThreadPool.h"
+#include "BinaryMesh.h"
+
+namespace mito {
+
+    // A .summit mesh file of dimension D, parsed: the header, then one vertex per line (its D
+    // coordinates) and one element per line (its type, the 1-based indices of its vertices and the
+    // label of its element set), the type of an element being its number of vertices (3 for
+    // triangles, 4 for tetrahedra). The file is mapped in memory and the start of each line is found
+    // in one pass; the lines are then parsed with std::from_chars (no locale, no stream state)
+    // straight into the arrays of the vertices and of the elements, in parallel chunks.
+    template <int D>
+    class SummitFile {
+
+      public:
+        // the largest number of vertices of an element (tetrahedra)
+        static constexpr int V = 4;
+
+        // the number of vertices of the elements of type {type} (0 for an unknown type)
+        static inline int nVertices(int type) { return (type == 3 || type == 4) ? type : 0; }
+
+      public:
+        /**
+         * constructor
+         * @param[in] fileName the name of the .summit file
+         * @param[in] pool the threads parsing the lines
+         */
+        inline SummitFile(const std::string & fileName, ThreadPool & pool) :
+            _file(fileName),
+            _good(false),
+            _nVertices(0),
+            _nElements(0),
+            _nElementSets(0),
+            _lines(),
+            _coordinates(),
+            _types(),
+            _vertices(),
+            _labels()
+        {
+            _good = _file.isOpen() && _parseHeader() && _findLines() && _parseVertices(pool)
+                 && _parseElements(pool);
+        }
+
+      private:
+        // delete copy constructor
+        SummitFile(const SummitFile &) = delete;
+
+        // delete assignment operator
+        const SummitFile & operator=(const SummitFile &) = delete;
+
+      public:
+        // whether the file was read and parsed without errors
+        inline bool good() const { return _good; }
+
+        // the number of vertices, elements and element sets
+        inline int nVertices() const { return _nVertices; }
+        inline int nElements() const { return _nElements; }
+        inline int nElementSets() const { return _nElementSets; }
+
+        // the D coordinates of vertex {v}
+        inline std::span<const real, D> coordinates(int v) const
+        {
+            return std::span<const real, D>(_coordinates.data() + D * v, D);
+        }
+
+        // the type of element {e}
+        inline int type(int e) const { return _types[e]; }
+
+        // the (0-based) indices of the vertices of element {e} (none if its type is unknown)
+        inline std::span<const int> vertices(int e) const
+        {
+            return std::span<const int>(_vertices.data() + V * e, nVertices(_types[e]));
+        }
+
+        // the label of the element set of element {e} of a known type (valid while the file is
+        // alive)
+        inline std::string_view label(int e) const { return _labels[e]; }
+
+      private:
+        // helper function: whether {c} separates the values on a line
+        static inline bool _isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+        // helper function: parse a value at {p} (after blanks) and move {p} past it
+        template <class T>
+        static inline bool _parse(const char *& p, const char * end, T & value)
+        {
+            while (p < end && _isBlank(*p)) {
+                ++p;
+            }
+            auto result = std::from_chars(p, end, value);
+            if (result.ec != std::errc() || (result.ptr < end && !_isBlank(*result.ptr))) {
+                return false;
+            }
+            p = result.ptr;
+            return true;
+        }
+
+        // helper function: whether there are only blanks from {p} to {end}
+        static inline bool _isBlankUntil(const char * p, const char * end)
+        {
+            while (p < end && _isBlank(*p)) {
+                ++p;
+            }
+            return p == end;
+        }
+
+        // helper function: the end of the line starting at {p}
+        inline const char * _endOfLine(const char * p) const
+        {
+            const char * end = _file.at<char>(0) + _file.size();
+            if (p >= end) {
+                return end;
+            }
+            const char * newline = static_cast<const char *>(std::memchr(p, '\n', end - p));
+            return newline == nullptr ? end : newline;
+        }
+
+        // helper function: parse the header (the dimension, and the number of vertices, elements
+        // and element sets, on the first lines of the file)
+        inline bool _parseHeader()
+        {
+            const char * p = _file.at<char>(0);
+            const char * end = p + _file.size();
+
+            // the four numbers of the header, on one or more lines
+            int header[4];
+            for (auto & value : header) {
+                while (p < end && (_isBlank(*p) || *p == '\n')) {
+                    ++p;
+                }
+                if (!_parse(p, _endOfLine(p), value)) {
+                    std::cout << "Error: Malformed mesh header" << std::endl;
+                    return false;
+                }
+            }
+
+            // assert the dimension of the mesh is D
+            if (header[0] != D) {
+                std::cout << "Error: Mesh of dimension " << header[0] << ", expected " << D
+                          << std::endl;
+                return false;
+            }
+            if (header[1] < 0 || header[2] < 0 || header[3] < 0) {
+                std::cout << "Error: Malformed mesh header" << std::endl;
+                return false;
+            }
+            _nVertices = header[1];
+            _nElements = header[2];
+            _nElementSets = header[3];
+
+            // the vertices start on the next line
+            _lines.push_back(_endOfLine(p));
+
+            // all done
+            return true;
+        }
+
+        // helper function: find the start of the lines of the vertices and of the elements
+        // (skipping blank lines)
+        inline bool _findLines()
+        {
+            const char * end = _file.at<char>(0) + _file.size();
+            const char * p = _lines.back();
+            _lines.clear();
+            _lines.reserve(_nVertices + _nElements);
+            while (p < end && int(_lines.size()) < _nVertices + _nElements) {
+                // the start of the next line
+                ++p;
+                // skip blank lines
+                const char * next = _endOfLine(p);
+                if (!_isBlankUntil(p, next)) {
+                    _lines.push_back(p);
+                }
+                p = next;
+            }
+
+            // assert the file has a line for each vertex and each element
+            if (int(_lines.size()) < _nVertices + _nElements) {
+                std::cout << "Error: Truncated mesh file" << std::endl;
+                return false;
+            }
+
+            // all done
+            return true;
+        }
+
+        // helper function: report the malformed lines of the entities named {entity}
+        static inline bool _report(const std::vector<char> & malformed, const char * entity)
+        {
+            bool good = true;
+            for (int n = 0; n < int(malformed.size()); ++n) {
+                if (malformed[n]) {
+                    std::cout << "Error: Malformed line for " << entity << " " << n + 1
+                              << std::endl;
+                    good = false;
+                }
+            }
+            return good;
+        }
+
+        // helper function: parse the coordinates of the vertices
+        inline bool _parseVertices(ThreadPool & pool)
+        {
+            _coordinates.resize(D * _nVertices);
+            std::vector<char> malformed(_nVertices, false);
+            pool.parallel_for(_nVertices, _chunk, [&](int begin, int end) {
+                for (int v = begin; v < end; ++v) {
+                    const char * p = _lines[v];
+                    const char * eol = _endOfLine(p);
+                    bool good = true;
+                    for (int d = 0; d < D; ++d) {
+                        good = good && _parse(p, eol, _coordinates[D * v + d]);
+                    }
+                    malformed[v] = !(good && _isBlankUntil(p, eol));
+                }
+            });
+
+            // all done
+            return _report(malformed, "vertex");
+        }
+
+        // helper function: parse the types, vertices and labels of the elements
+        inline bool _parseElements(ThreadPool & pool)
+        {
+            _types.resize(_nElements);
+            _vertices.resize(V * _nElements);
+            _labels.resize(_nElements);
+            std::vector<char> malformed(_nElements, false);
+            pool.parallel_for(_nElements, _chunk, [&](int begin, int end) {
+                for (int e = begin; e < end; ++e) {
+                    const char * p = _lines[_nVertices + e];
+                    const char * eol = _endOfLine(p);
+                    // the type of the element
+                    if (!_parse(p, eol, _types[e])) {
+                        malformed[e] = true;
+                        continue;
+                    }
+                    // the unknown types are reported when the mesh is built
+                    if (nVertices(_types[e]) == 0) {
+                        continue;
+                    }
+                    // the vertices (1-based in the file)
+                    bool good = true;
+                    for (int v = 0; v < nVertices(_types[e]); ++v) {
+                        int & vertex = _vertices[V * e + v];
+                        good = good && _parse(p, eol, vertex) && vertex >= 1
+                            && vertex <= _nVertices;
+                        --vertex;
+                    }
+                    // the label of the element set
+                    while (p < eol && _isBlank(*p)) {
+                        ++p;
+                    }
+                    const char * label = p;
+                    while (p < eol && !_isBlank(*p)) {
+                        ++p;
+                    }
+                    _labels[e] = std::string_view(label, p - label);
+                    malformed[e] = !(good && !_labels[e].empty() && _isBlankUntil(p, eol));
+                }
+            });
+
+            // all done
+            return _report(malformed, "element");
+        }
+
+      private:
+        // the number of lines parsed by a thread at a time
+        static constexpr int _chunk = 4096;
+        // the mapped file
+        MappedFile _file;
+        // whether the file was parsed without errors
+        bool _good;
+        // the number of vertices, elements and element sets
+        int _nVertices;
+        int _nElements;
+        int _nElementSets;
+        // the start of the line of each vertex and each element
+        std::vector<const char *> _lines;
+        // the coordinates of the vertices
+        std::vector<real> _coordinates;
+        // the types of the elements
+        std::vector<int> _types;
+        // the vertices of the elements
+        std::vector<int> _vertices;
+        // the labels of the elements
+        std::vector<std::string_view> _labels;
+    };
+
+}    // namespace mito
+
+#endif    // mito_mesh_SummitFile_h
+
+// end of file
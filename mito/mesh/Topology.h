@@ -0,0 +1,195 @@
+// code guard
+#if !defined(mito_mesh_Topology_h)
+#define mito_mesh_Topology_h
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "../mito.h"
+
+namespace mito {
+
+    // The topology of a mesh of simplices of dimension D as indices: the entities of dimension I
+    // are numbered 0, ..., nEntities<I>() - 1, and
+    //  - (downward) the composition of each entity of dimension I >= 1 is the I + 1 indices of its
+    //    entities of dimension I - 1, stored contiguously entity after entity, and
+    //  - (upward) the cofaces of each entity of dimension I < D, i.e. the entities of dimension
+    //    I + 1 it is part of, are stored in compressed sparse row format (the cofaces of entity
+    //    {e} are those from offset {e} to offset {e + 1}).
+    // With 32-bit indices, this takes half the memory of the pointers of the simplices, and
+    // traversals read contiguous arrays.
+    template <int D>
+    class Topology {
+
+      public:
+        // the type of the indices of the entities
+        using index_type = std::int32_t;
+
+      public:
+        // constructor
+        inline Topology() : _n(), _down(), _offsets(), _up() {}
+
+      public:
+        // set the number of vertices
+        inline void setVertices(int n)
+        {
+            _n[0] = n;
+
+            // all done
+            return;
+        }
+
+        // make room for {n} entities of dimension I
+        template <int I>
+        inline void reserve(int n)
+        {
+            static_assert(I >= 1 && I <= D);
+            _down[I].reserve((I + 1) * n);
+
+            // all done
+            return;
+        }
+
+        // add an entity of dimension I composed of the entities {composition} of dimension I - 1
+        template <int I>
+        inline index_type addEntity(const std::array<index_type, I + 1> & composition)
+        {
+            static_assert(I >= 1 && I <= D);
+            _down[I].insert(_down[I].end(), composition.begin(), composition.end());
+
+            // all done
+            return _n[I]++;
+        }
+
+        // compute the cofaces of all entities (once all entities are added)
+        inline void finalize()
+        {
+            for (int I = 0; I < D; ++I) {
+                // count the cofaces of each entity of dimension I
+                std::vector<index_type> & offsets = _offsets[I];
+                offsets.assign(_n[I] + 1, 0);
+                for (auto e : _down[I + 1]) {
+                    ++offsets[e + 1];
+                }
+                for (int e = 0; e < _n[I]; ++e) {
+                    offsets[e + 1] += offsets[e];
+                }
+
+                // list the cofaces of each entity of dimension I (in increasing order)
+                std::vector<index_type> & up = _up[I];
+                up.resize(offsets[_n[I]]);
+                std::vector<index_type> next(offsets.begin(), offsets.end() - 1);
+                for (int f = 0; f < _n[I + 1]; ++f) {
+                    for (int k = 0; k < I + 2; ++k) {
+                        up[next[_down[I + 1][(I + 2) * f + k]]++] = f;
+                    }
+                }
+            }
+
+            // all done
+            return;
+        }
+
+      public:
+        // the number of entities of dimension I
+        template <int I>
+        inline int nEntities() const
+        {
+            return _n[I];
+        }
+
+        // the indices of the entities of dimension I - 1 composing entity {e} of dimension I
+        template <int I>
+        inline std::span<const index_type, I + 1> composition(index_type e) const
+        {
+            static_assert(I >= 1 && I <= D);
+            return std::span<const index_type, I + 1>(_down[I].data() + (I + 1) * e, I + 1);
+        }
+
+        // the compositions of all entities of dimension I, one entity after the other
+        template <int I>
+        inline std::span<const index_type> compositions() const
+        {
+            static_assert(I >= 1 && I <= D);
+            return _down[I];
+        }
+
+        // the indices of the entities of dimension I + 1 that entity {e} of dimension I is part of
+        template <int I>
+        inline std::span<const index_type> cofaces(index_type e) const
+        {
+            static_assert(I >= 0 && I < D);
+            return std::span<const index_type>(
+                _up[I].data() + _offsets[I][e], _offsets[I][e + 1] - _offsets[I][e]);
+        }
+
+        // the indices of the vertices of entity {e} of dimension I (in increasing order)
+        template <int I>
+        inline std::array<index_type, I + 1> vertices(index_type e) const
+        {
+            if constexpr (I == 0) {
+                return { e };
+            } else if constexpr (I == 1) {
+                auto composition = this->composition<1>(e);
+                return { std::min(composition[0], composition[1]),
+                         std::max(composition[0], composition[1]) };
+            } else {
+                // the vertices of the first face of {e} and the one vertex of the second face that
+                // is not in the first face
+                auto composition = this->composition<I>(e);
+                auto first = vertices<I - 1>(composition[0]);
+                auto second = vertices<I - 1>(composition[1]);
+                index_type other = -1;
+                for (auto v : second) {
+                    if (std::find(first.begin(), first.end(), v) == first.end()) {
+                        other = v;
+                    }
+                }
+                // assert the faces share all vertices but one
+                assert(other != -1);
+
+                // insert the other vertex among those of the first face, in increasing order
+                std::array<index_type, I + 1> vertices;
+                int k = I;
+                for (; k > 0 && first[k - 1] > other; --k) {
+                    vertices[k] = first[k - 1];
+                }
+                vertices[k] = other;
+                for (; k > 0; --k) {
+                    vertices[k - 1] = first[k - 1];
+                }
+                return vertices;
+            }
+        }
+
+        // the bytes of memory held by the topology
+        inline std::size_t bytes() const
+        {
+            std::size_t bytes = 0;
+            for (int I = 0; I <= D; ++I) {
+                bytes += _down[I].capacity() * sizeof(index_type);
+            }
+            for (int I = 0; I < D; ++I) {
+                bytes += (_offsets[I].capacity() + _up[I].capacity()) * sizeof(index_type);
+            }
+            return bytes;
+        }
+
+      private:
+        // the number of entities of each dimension
+        std::array<int, D + 1> _n;
+        // the compositions of the entities of each dimension (none for vertices)
+        std::array<std::vector<index_type>, D + 1> _down;
+        // the offsets of the cofaces of the entities of each dimension (but D)
+        std::array<std::vector<index_type>, D> _offsets;
+        // the cofaces of the entities of each dimension (but D)
+        std::array<std::vector<index_type>, D> _up;
+    };
+
+}    // namespace mito
+
+#endif    // mito_mesh_Topology_h
+
+// end of file
@@ -2,19 +2,23 @@
 #if !defined(mito_mesh_VertexPointMap_h)
 #define mito_mesh_VertexPointMap_h
 
+#include <mutex>
 #include "Simplex.h"
 
 namespace mito {
 
+    // The coordinates of the vertices of a mesh: the points are stored by value, one after the
+    // other, in one contiguous array indexed by the vertex id (the order in which the vertices were
+    // inserted), so that the coordinates of vertex {v} are read with one indexing. The map from the
+    // vertices addresses to their ids is only needed to look vertices up by address: it is built
+    // on the first such lookup (and extended on the next ones with the vertices inserted since).
     template <int D>
     class VertexPointMap {
 
-        // using map_t = std::unordered_map<std::reference_wrapper<vertex_t>, point_t<D>>;
-        // TODO: test O for access
-        using map_t = std::unordered_map<const vertex_t *, const point_t<D> *>;
+        using map_t = std::unordered_map<const vertex_t *, int>;
 
       public:
-        VertexPointMap() : _map() {};
+        VertexPointMap() : _points(), _vertices(), _map(), _mutex() {};
 
         ~VertexPointMap() {}
 
@@ -34,38 +38,84 @@ namespace mito {
       public:
         void print()
         {
-            // iterate on map
-            for (auto item : _map) {
-                std::cout << "Vertex: " << item.first << std::endl;
-                std::cout << "Point: " << *item.second << std::endl;
+            // iterate on vertices
+            for (int v = 0; v < size(); ++v) {
+                std::cout << "Vertex: " << _vertices[v] << std::endl;
+                std::cout << "Point: " << _points[v] << std::endl;
             }
             // all done
             return;
         }
 
-        int size() { return _map.size(); }
+        int size() const { return _points.size(); }
 
-        auto insert(const vertex_t & vertex, const point_t<D> & point)
+        // make room for {n} vertices
+        void reserve(int n)
         {
-            return _map.insert(
-                // std::pair<std::reference_wrapper<vertex_t>, point_t<D>>(vertex, point)
-                std::pair<const vertex_t *, const point_t<D> *>(&vertex, &point));
+            _points.reserve(n);
+            _vertices.reserve(n);
+
+            // all done
+            return;
+        }
+
+        // associate (a copy of) {point} to {vertex}, which is not in the map yet, and return the id
+        // of {vertex}
+        int insert(const vertex_t & vertex, const point_t<D> & point)
+        {
+            _points.push_back(point);
+            _vertices.push_back(&vertex);
+
+            // all done
+            return _points.size() - 1;
         }
 
+        // the id of {vertex} (looked up by address)
+        int index(const vertex_t * vertex) const
+        {
+            // the map is extended and read under the lock, as lookups may be concurrent
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // add the vertices inserted since the last lookup to the map
+            _map.reserve(_vertices.size());
+            for (int v = _map.size(); v < size(); ++v) {
+                [[maybe_unused]] bool inserted = _map.emplace(_vertices[v], v).second;
+                // assert each vertex was inserted once
+                assert(inserted);
+            }
+
+            auto id = _map.find(vertex);
+            // assert the vertex is in the map
+            assert(id != _map.end());
+            return id->second;
+        }
+
+        // the coordinates of the vertex with id {v}
+        const point_t<D> & operator[](int v) const { return _points[v]; }
+
         const point_t<D> & operator[](const vertex_t * vertex) const
         {
-            auto point = _map.find(vertex);
-            return *(point->second);
+            return _points[index(vertex)];
         }
 
         const point_t<D> & operator[](const vertex_t & vertex) const
         {
-            auto point = _map.find(&vertex);
-            return *(point->second);
+            return _points[index(&vertex)];
         }
 
+        // the coordinates of all vertices, in the order of their ids
+        const std::vector<point_t<D>> & points() const { return _points; }
+
       private:
-        map_t _map;
+        // the coordinates of the vertices
+        std::vector<point_t<D>> _points;
+        // the vertices, by id
+        std::vector<const vertex_t *> _vertices;
+        // the ids of the vertices, by address (of the first {_map.size()} vertices)
+        mutable map_t _map;
+        // guard of the map, which lookups extend and read (lookups may run concurrently with each
+        // other, but not with insertions)
+        mutable std::mutex _mutex;
     };
 
 }    // namespace mito
@@ -1,6 +1,7 @@
 #ifndef __MITO__
 #define __MITO__
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <functional>
@@ -85,6 +86,11 @@ namespace mito {
         static constexpr int value = 1;
     };
 
+    template <>
+    struct size<float> {
+        static constexpr int value = 1;
+    };
+
     template <typename T>
     struct type {
         using value = typename T ::type;
@@ -104,6 +110,22 @@ namespace mito {
     struct type<double> {
         using value = double;
     };
+
+    template <>
+    struct type<float> {
+        using value = float;
+    };
+
+    // the same type with underlying type T2 (e.g. a vector_t of doubles for a vector_t of floats)
+    template <typename T, typename T2>
+    struct rebind {
+        using value = T2;
+    };
+
+    template <typename T, int... I, typename T2>
+    struct rebind<SmallGrid<T, I...>, T2> {
+        using value = SmallGrid<T2, I...>;
+    };
 }
 
 namespace mito {
@@ -0,0 +1,184 @@
+// code guard
+#if !defined(mito_parallel_ThreadPool_h)
+#define mito_parallel_ThreadPool_h
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../mito.h"
+
+namespace mito {
+
+    // A pool of threads running the chunks of a range of indices in parallel. The chunks are
+    // assigned to the threads statically (chunk {c} runs on thread {c % threads()}), so that:
+    //  - the results do not depend on the timing of the threads, and
+    //  - over repeated loops on the same range a thread always works on the same indices: memory
+    //    first touched by a thread in a loop (placed on its NUMA node) is used by that same thread
+    //    in the following loops.
+    // Chunks much smaller than the range per thread balance the load of nonuniform work.
+    class ThreadPool {
+
+      public:
+        /**
+         * constructor
+         * @param[in] threads the number of threads (the calling thread and {threads - 1} workers)
+         */
+        inline ThreadPool(int threads = std::thread::hardware_concurrency()) :
+            _workers(),
+            _mutex(),
+            _wake(),
+            _done(),
+            _body(nullptr),
+            _n(0),
+            _chunk(1),
+            _generation(0),
+            _pending(0),
+            _stop(false)
+        {
+            // start the workers
+            for (int thread = 1; thread < std::max(threads, 1); ++thread) {
+                _workers.emplace_back([this, thread]() { _work(thread); });
+            }
+
+            // all done
+            return;
+        }
+
+        // destructor
+        inline ~ThreadPool()
+        {
+            // stop the workers
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _wake.notify_all();
+            for (auto & worker : _workers) {
+                worker.join();
+            }
+        }
+
+        // delete copy constructor
+        ThreadPool(const ThreadPool &) = delete;
+
+        // delete assignment operator
+        ThreadPool & operator=(const ThreadPool &) = delete;
+
+      public:
+        // the number of threads
+        inline int threads() const { return _workers.size() + 1; }
+
+        /**
+         * run {body(begin, end)} on the chunks of (at most) {chunk} indices of [0, n), in parallel,
+         * and return when all chunks are done
+         */
+        inline void parallel_for(int n, int chunk, const std::function<void(int, int)> & body)
+        {
+            // assert the pool is not already running a loop
+            assert(_body == nullptr);
+            assert(chunk > 0);
+
+            // nothing to share
+            if (threads() == 1 || n <= chunk) {
+                for (int begin = 0; begin < n; begin += chunk) {
+                    body(begin, std::min(begin + chunk, n));
+                }
+                return;
+            }
+
+            // hand the loop to the workers
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _body = &body;
+                _n = n;
+                _chunk = chunk;
+                _pending = _workers.size();
+                ++_generation;
+            }
+            _wake.notify_all();
+
+            // the calling thread is thread 0
+            _run(0);
+
+            // wait for the workers
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _done.wait(lock, [this]() { return _pending == 0; });
+                _body = nullptr;
+            }
+
+            // all done
+            return;
+        }
+
+      private:
+        // helper function: run the chunks of the current loop assigned to {thread}
+        inline void _run(int thread) const
+        {
+            int T = threads();
+            for (int begin = thread * _chunk; begin < _n; begin += T * _chunk) {
+                (*_body)(begin, std::min(begin + _chunk, _n));
+            }
+
+            // all done
+            return;
+        }
+
+        // helper function: the loop of worker {thread}, running its share of each loop
+        inline void _work(int thread)
+        {
+            int generation = 0;
+            while (true) {
+                // wait for a loop (or for the pool to stop)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _wake.wait(lock, [&]() { return _stop || _generation != generation; });
+                    if (_stop) {
+                        return;
+                    }
+                    generation = _generation;
+                }
+
+                // run its chunks
+                _run(thread);
+
+                // report it is done
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (--_pending == 0) {
+                        _done.notify_one();
+                    }
+                }
+            }
+        }
+
+      private:
+        // the worker threads
+        std::vector<std::thread> _workers;
+        // the mutex guarding the state of the loop
+        std::mutex _mutex;
+        // signals the workers a new loop (or to stop)
+        std::condition_variable _wake;
+        // signals the calling thread the workers are done
+        std::condition_variable _done;
+        // the body of the current loop
+        const std::function<void(int, int)> * _body;
+        // the number of indices of the current loop
+        int _n;
+        // the size of the chunks of the current loop
+        int _chunk;
+        // the number of loops handed to the workers
+        int _generation;
+        // the number of workers still running the current loop
+        int _pending;
+        // whether the workers should stop
+        bool _stop;
+    };
+
+}    // namespace mito
+
+#endif    // mito_parallel_ThreadPool_h
+
+// end of file
@@ -2,6 +2,8 @@
 #if !defined(mito_quadrature_Integrator_h)
 #define mito_quadrature_Integrator_h
 
+#include <map>
+#include <memory>
 #include "../mito.h"
 #include "../mesh/ElementSet.h"
 #include "../math/Field.h"
@@ -13,8 +15,11 @@ namespace mito {
     // TODO: Keep in mind that we will need integrator and the above defined fields to compute
     // integrals of contact forces down the road. Do we have enough machinery for that?
 
-    // template with respect to element type T and to degree of exactness r of quadrature rule
-    template <class quadrature_t, int r, class element_set_t>
+    // template with respect to element type T and to degree of exactness r of quadrature rule, and
+    // to the scalar type of the coordinates of the quadrature points: with {precision_t = float}
+    // fields are evaluated and stored in single precision, while the integrals are accumulated in
+    // double precision (mixed precision)
+    template <class quadrature_t, int r, class element_set_t, typename precision_t = real>
     class Integrator {
         using element_t = typename element_set_t::element;
         static constexpr int D = element_set_t::dim;
@@ -34,26 +39,22 @@ namespace mito {
             // QUESTION: 3 out 4 of these loops can be unrolled as Q, D, V are template parameters
             //           Is there anything we can do about it?
 
+            // number of vertices
+            constexpr int V = element_t::parametricDim;
+
             // loop on elements
-            int e = 0;
-            for (const auto & element : _elementSet.elements()) {
-                // use a set to collect vertices without repeated entries
-                std::set<const vertex_t *> vertices;
-                element->getVertices(vertices);
+            for (int e = 0; e < _elementSet.nElements(); ++e) {
                 // loop on vertices
-                int v = 0;
-                for (const auto & vertex : vertices) {
+                for (int v = 0; v < V; ++v) {
+                    const auto & vertexCoordinates = _elementSet.coordinatesVertex(e, v);
                     // loop on quadrature point
                     for (int q = 0; q < Q; ++q) {
                         for (int d = 0; d < D; ++d) {
-                            const auto & vertexCoordinates = _elementSet.coordinatesVertex(vertex);
                             _coordinates[{ e, q }][d] +=
                                 _quadratureRule.getPoint(q)[v] * vertexCoordinates[d];
                         }
                     }
-                    ++v;
                 }
-                ++e;
             }
 
             // all done
@@ -63,31 +64,99 @@ namespace mito {
       public:
         Integrator(const element_set_t & elementSet) :
             _elementSet(elementSet),
-            _coordinates(elementSet.nElements())
+            _coordinates(elementSet.nElements()),
+            _memoize(false),
+            _memo()
         {
             _computeQuadPointCoordinates();
         }
 
         template <typename Y>
-        Y integrate(const Field<vector_t<D>, Y> & field)
+        auto integrate(const Field<vector_t<D, precision_t>, Y> & field)
         {
             std::cout << "integrating ... " << std::endl;
 
-            auto values = field(_coordinates);
+            // with memoization, integrate the values of the field computed the first time
+            if (_memoize) {
+                return integrate(_memoized(field));
+            }
+
+            // all done
+            return integrate(field(_coordinates));
+        }
+
+        // turn on (or off) the memoization of the values of the fields at the quadrature points, so
+        // that integrating again a field (or one of its copies) costs only the weighted sum of its
+        // values
+        inline void memoize(bool memoize = true)
+        {
+            _memoize = memoize;
+            // forget the memoized values
+            if (!memoize) {
+                _memo.clear();
+            }
+        }
+
+        // recompute the coordinates of the quadrature points (e.g. after the vertices of the
+        // element set moved), forgetting the memoized values
+        inline void updateCoordinates()
+        {
+            _coordinates.reset();
+            _computeQuadPointCoordinates();
+            _memo.clear();
+        }
 
-            Y result;
+        // integrate the values of a field at the quadrature points (e.g. those of a time
+        // dependent field cached at the coordinates of the quadrature points)
+        template <int N, typename Y>
+        auto integrate(const quadrature_field_t<N, Y> & values)
+        {
+            // assert the values are given at the quadrature points of this integrator
+            static_assert(N == Q);
+            assert(values.n_elements() == _elementSet.nElements());
+
+            // the integral is accumulated in double precision
+            using accumulator_t = typename rebind<Y, real>::value;
+            accumulator_t result;
 
             // assemble elementary contributions
             for (auto e = 0; e < _elementSet.nElements(); ++e) {
                 for (auto q = 0; q < Q; ++q) {
-                    result +=
-                        values[{ e, q }] * _quadratureRule.getWeight(q) * _elementSet.jacobian(e);
+                    result += accumulator_t(values[{ e, q }]) * _quadratureRule.getWeight(q)
+                            * _elementSet.jacobian(e);
                 }
             }
 
             return result;
         }
 
+        // accessor for the coordinates of the quadrature points
+        inline const auto & coordinates() const { return _coordinates; }
+
+      private:
+        // the values of {field} at the quadrature points, memoized
+        template <typename Y>
+        const auto & _memoized(const Field<vector_t<D, precision_t>, Y> & field)
+        {
+            using values_t = quadrature_field_t<Q, Y>;
+
+            // the values memoized for the field, if it is still the same field
+            auto found = _memo.find(field.identity().get());
+            if (found != _memo.end() && !found->second.first.expired()) {
+                return *std::static_pointer_cast<const values_t>(found->second.second);
+            }
+
+            // forget the values of the fields that do not exist anymore
+            std::erase_if(_memo, [](const auto & entry) { return entry.second.first.expired(); });
+
+            // evaluate the field and memoize its values
+            auto values = std::make_shared<const values_t>(field(_coordinates));
+            _memo[field.identity().get()] = { field.identity(), values };
+
+            // all done
+            return *values;
+        }
+
       private:
         // the quadrature rule
         static constexpr auto _quadratureRule = QuadratureRule::Get();
@@ -98,7 +167,13 @@ namespace mito {
         // the domain of integration
         const element_set_t & _elementSet;
         // the coordinates of the quadrature points in the domain of integration
-        quadrature_field_t<Q, vector_t<D>> _coordinates;
+        quadrature_field_t<Q, vector_t<D, precision_t>> _coordinates;
+        // whether the values of the fields at the quadrature points are memoized
+        bool _memoize;
+        // the memoized values, by field identity (held weakly, so that the values of a field that
+        // does not exist anymore are never mistaken for those of another field)
+        std::map<const void *, std::pair<std::weak_ptr<const void>, std::shared_ptr<const void>>>
+            _memo;
     };
 
 }    // namespace  mito
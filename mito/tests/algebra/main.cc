@@ -34,6 +34,99 @@ main()
     mito::vector_t<3> y = a * A * x;
     assert((y == a * mito::vector_t<3> { 3, 12, 21 }));
 
+    // expressions are evaluated lazily on assignment
+    mito::vector_t<3> w = 2.0 * x + y - x / 2.0;
+    assert((w == mito::vector_t<3> { 4.5, 13.5, 22.5 }));
+    // even when the assigned grid appears in the expression
+    x = A * x + x;
+    assert((x == mito::vector_t<3> { 4, 13, 22 }));
+    w += A * (w - y);
+    assert((w == mito::vector_t<3> { 4.5, 13.5, 22.5 } + A * mito::vector_t<3> { 4.5, 13.5, 22.5 }
+                     - A * mito::vector_t<3> { 3, 12, 21 }));
+    // non-square matrices
+    mito::tensor_t<2, 3> B = { 1, 0, 0, 0, 1, 0 };
+    assert((B * x == mito::vector_t<2> { 4, 13 }));
+
+    // matrix-matrix product, transpose, dyadic product, double contraction and trace
+    mito::tensor_t<3> C = mito::dot(A, A);
+    assert((C == mito::tensor_t<3> { 15, 18, 21, 42, 54, 66, 69, 90, 111 }));
+    assert((mito::transpose(B) == mito::tensor_t<3, 2> { 1, 0, 0, 1, 0, 0 }));
+    assert((mito::dot(B, mito::transpose(B)) == mito::tensor_t<2> { 1, 0, 0, 1 }));
+    assert((mito::dot(mito::transpose(A), A)
+            == mito::dot(mito::transpose(A), mito::transpose(mito::transpose(A)))));
+    assert((mito::transpose(A) * x == mito::vector_t<3> { 171, 210, 249 }));
+    mito::vector_t<2> u = { 1, 2 };
+    assert((mito::dyadic(u, x) == mito::tensor_t<2, 3> { 4, 13, 22, 8, 26, 44 }));
+    assert(
+        (mito::dot(mito::dyadic(u, x), mito::transpose(B)) == mito::tensor_t<2> { 4, 13, 8, 26 }));
+    assert(mito::ddot(A, A) == 204);
+    // A * B of tensors is still the double contraction (deprecated in favor of ddot)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    assert(A * A == 204);
+#pragma GCC diagnostic pop
+    assert(mito::ddot(A, mito::transpose(A)) == mito::ComputeTrace(mito::dot(A, A)));
+    assert(mito::ComputeTrace(A) == 12);
+    // the full contraction of grids of higher rank
+    mito::SmallGrid<mito::real, 2, 2, 2> G { 1, 2, 3, 4, 5, 6, 7, 8 };
+    assert(mito::ddot(G, G) == 204);
+    assert(mito::ComputeTrace(mito::dyadic(x, x)) == x * x);
+    // even when the assigned grid appears in the expression
+    C = mito::dot(mito::transpose(C), A);
+    assert((C == mito::tensor_t<3> { 540, 666, 792, 702, 864, 1026, 864, 1062, 1260 }));
+
+    // the algebra is generic with respect to the scalar type
+    mito::vector_t<3, float> xf = { 1.0f, 2.0f, 3.0f };
+    mito::tensor_t<3, 3, float> Af = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+    mito::vector_t<3, float> yf = 2 * xf - Af * xf / 2.0f + 0.5 * xf;
+    static_assert(std::is_same_v<decltype(xf * yf), float>);
+    assert((yf == mito::vector_t<3, float> { -1.5f, -8.0f, -14.5f }));
+    // and grids convert between scalar types
+    assert((mito::vector_t<3>(xf) == mito::vector_t<3> { 1.0, 2.0, 3.0 }));
+    static_assert(std::is_same_v<
+                  mito::rebind<mito::vector_t<3, float>, mito::real>::value, mito::vector_t<3>>);
+
+    // grids are stored inline: trivially copyable, no padding, usable in constant expressions
+    static_assert(std::is_trivially_copyable_v<mito::tensor_t<3>>);
+    static_assert(sizeof(mito::vector_t<3>) == 3 * sizeof(mito::real));
+    static_assert(alignof(mito::tensor_t<2>) == 4 * sizeof(mito::real));
+    constexpr mito::vector_t<2> z = { 1.0, 2.0 };
+    static_assert(z[0] == 1.0 && z[1] == 2.0);
+    static_assert(mito::scalar_t<>() == 0.0);
+
+    // the generic determinant (LU factorization) agrees with the closed forms
+    constexpr mito::tensor_t<2> A2 = { 2, 1, 1, 3 };
+    constexpr mito::tensor_t<3> A3 = { 0, 1, 2, 3, 4, 5, 6, 7, 9 };
+    constexpr mito::tensor_t<4> A4 = { 0, 2, 1, 0, 1, 0, 0, 3, 4, 1, 2, 0, 0, 1, 1, 1 };
+    static_assert(mito::ComputeDeterminant(A2) == 5.0);
+    static_assert(mito::ComputeDeterminant<2, mito::real>(A2) == 5.0);
+    static_assert(mito::ComputeDeterminant(A3) == -3.0);
+    static_assert(mito::ComputeDeterminant<3, mito::real>(A3) == -3.0);
+    static_assert(mito::ComputeDeterminant(A4) == mito::ComputeDeterminant<4, mito::real>(A4));
+    // beyond the closed forms
+    constexpr mito::tensor_t<5> A5 = { 2, 0, 0, 0, 1, 0, 3, 0, 0, 0, 0, 0, 0, 1, 0,
+                                       0, 0, 4, 0, 0, 1, 0, 0, 0, 1 };
+    static_assert(mito::ComputeDeterminant(A5) == -12.0);
+    // the generic inverse and linear solve
+    mito::tensor_t<5> invA5;
+    assert(mito::ComputeInverse(A5, invA5) == -12.0);
+    mito::tensor_t<5> I5 = { 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0,
+                             0, 0, 0, 1, 0, 0, 0, 0, 0, 1 };
+    mito::vector_t<5> e = { 1, 2, 3, 4, 5 };
+    for (int i = 0; i < 5; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            mito::real AinvAij = 0.0;
+            for (int k = 0; k < 5; ++k) {
+                AinvAij += A5[i * 5 + k] * invA5[k * 5 + j];
+            }
+            assert(std::abs(AinvAij - I5[i * 5 + j]) < 1.e-15);
+        }
+    }
+    mito::vector_t<5> x5 = mito::Solve(A5, e);
+    assert((A5 * x5 == e));
+    constexpr mito::vector_t<3> b3 = { 3, 12, 22 };
+    static_assert((mito::Solve(A3, b3) == mito::vector_t<3> { 1, 1, 1 }));
+
     // all done
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <cmath>
+#include "../../math/Field.h"
+
+using mito::Dual;
+using mito::real;
+using mito::vector_t;
+
+static const real TOL = 1.e-15;
+
+int
+main()
+{
+    // a point
+    vector_t<2> x = { 0.3, 1.7 };
+
+    // arithmetic and elementary functions on dual numbers
+    auto X = mito::seed(x);
+    auto z = 2.0 * X[0] * X[1] - sqrt(X[1]) / X[0] + exp(X[0]) * sin(X[1]) - 1.0;
+    real dzdx = 2.0 * x[1] + std::sqrt(x[1]) / (x[0] * x[0]) + std::exp(x[0]) * std::sin(x[1]);
+    real dzdy = 2.0 * x[0] - 0.5 / (std::sqrt(x[1]) * x[0]) + std::exp(x[0]) * std::cos(x[1]);
+    assert(std::fabs(z.gradient()[0] - dzdx) < TOL);
+    assert(std::fabs(z.gradient()[1] - dzdy) < TOL);
+    assert(X[0] < X[1] && X[1] > 1.0);
+
+    // dual numbers through the Function algebra
+    using dual_t = Dual<2>;
+    mito::Function<vector_t<2, dual_t>, dual_t> f(
+        [](const vector_t<2, dual_t> & x) { return x[0] * x[1]; });
+    auto g = dual_t(3.0) * f + f;
+    vector_t<2> dg = { 4.0 * x[1], 4.0 * x[0] };
+    assert(g(X).gradient() == dg);
+
+    // a scalar field built from a generic function gets its gradient automatically
+    mito::ScalarField<2> field(mito::autodiff, [](const auto & x) { return cos(x[0] * x[1]); });
+    vector_t<2> gradient = { -std::sin(x[0] * x[1]) * x[1], -std::sin(x[0] * x[1]) * x[0] };
+    assert(field(x) == std::cos(x[0] * x[1]));
+    assert(std::fabs(field.Df(1)(x) - gradient[1]) < TOL);
+    assert(mito::grad(field, x) == gradient);
+    assert(mito::grad(field)(x) == gradient);
+    std::vector<vector_t<2>> points(2 * mito::batch_size + 1, x);
+    for (const auto & value : mito::grad(field)(points)) {
+        assert(value == gradient);
+    }
+
+    // comparisons (on the values) in a function differentiated automatically
+    mito::ScalarField<2> piecewise(mito::autodiff, [](const auto & x) {
+        return (x[0] == 0.0 || 1.0 != x[1]) && x[0] != x[1] ? x[0] * x[1] : x[0] + x[1];
+    });
+    assert(x[0] != x[1] && x[1] != 1.0);
+    assert(piecewise(x) == x[0] * x[1]);
+    assert((mito::grad(piecewise, x) == vector_t<2> { x[1], x[0] }));
+
+    // the sum of two fields differentiated automatically computes its derivatives at once too
+    auto sum = field + field;
+    assert(sum.jet());
+    assert(mito::grad(sum, x) == 2.0 * gradient);
+
+    // a generic function (here only valid on reals) without the tag builds a field without
+    // derivatives, which still takes part in the field algebra
+    mito::ScalarField<2> plain([](const auto & x) { return std::cos(x[0]) * x[1]; });
+    auto plainSum = plain + field;
+    assert(!plain.differentiable() && !plainSum.differentiable() && !plainSum.jet());
+    assert(plainSum(x) == plain(x) + field(x));
+
+    // so does a vector field, with its divergence
+    mito::VectorField<2, 2> vectorField(mito::autodiff, [](const auto & x) {
+        auto y = x;
+        y[0] = x[0] * x[1];
+        y[1] = log(x[1]) * x[0];
+        return y;
+    });
+    assert(std::fabs(mito::div(vectorField, x) - (x[1] + x[0] / x[1])) < TOL);
+    assert(mito::div(vectorField)(x) == mito::div(vectorField, x));
+    assert(std::fabs(mito::curl(vectorField, x) - (log(x[1]) - x[0])) < TOL);
+
+    // the jacobian and the curl of a 3D vector field, with partial derivatives computed
+    // automatically and by hand
+    using vector_function_t = mito::Function<vector_t<3>, vector_t<3>>;
+    auto u = [](const auto & x) {
+        auto y = x;
+        y[0] = x[1] * x[2];
+        y[1] = sin(x[0]) + x[2];
+        y[2] = x[0] * x[0] * x[1];
+        return y;
+    };
+    mito::VectorField<3, 3> fieldAD(mito::autodiff, u);
+    mito::VectorField<3, 3> field3D(
+        vector_function_t(u),
+        { vector_function_t([](const vector_t<3> & x) {
+              return vector_t<3> { 0.0, std::cos(x[0]), 2.0 * x[0] * x[1] };
+          }),
+          vector_function_t(
+              [](const vector_t<3> & x) { return vector_t<3> { x[2], 0.0, x[0] * x[0] }; }),
+          vector_function_t(
+              [](const vector_t<3> & x) { return vector_t<3> { x[1], 1.0, 0.0 }; }) });
+    std::vector<vector_t<3>> points3D(mito::batch_size + 5);
+    for (int k = 0; k < (int) points3D.size(); ++k) {
+        points3D[k] = vector_t<3> { 0.1 * k, 1.0 - 0.01 * k, 0.5 };
+    }
+    auto jacobians = mito::jacobian(field3D)(points3D);
+    auto jacobiansAD = mito::jacobian(fieldAD)(points3D);
+    auto curls = mito::curl(field3D)(points3D);
+    for (int k = 0; k < (int) points3D.size(); ++k) {
+        const auto & y = points3D[k];
+        assert(jacobians[k] == jacobiansAD[k]);
+        assert(jacobians[k] == mito::jacobian(field3D, y));
+        vector_t<3> curl = { y[0] * y[0] - 1.0, y[1] - 2.0 * y[0] * y[1], std::cos(y[0]) - y[2] };
+        assert(curls[k] == curl);
+        assert(mito::curl(fieldAD, y) == curl);
+        assert(mito::div(fieldAD, y) == 0.0);
+    }
+
+    // the jacobian of a field whose partial derivatives are evaluated in batch
+    using batch_function_t = mito::Function<vector_t<3>, vector_t<3>>;
+    mito::VectorField<3, 3> fieldBatch(
+        vector_function_t(u),
+        { batch_function_t([](const vector_t<3> * x, vector_t<3> * y, int n) {
+              for (int k = 0; k < n; ++k) {
+                  y[k] = vector_t<3> { 0.0, std::cos(x[k][0]), 2.0 * x[k][0] * x[k][1] };
+              }
+          }),
+          batch_function_t([](const vector_t<3> * x, vector_t<3> * y, int n) {
+              for (int k = 0; k < n; ++k) {
+                  y[k] = vector_t<3> { x[k][2], 0.0, x[k][0] * x[k][0] };
+              }
+          }),
+          batch_function_t([](const vector_t<3> * x, vector_t<3> * y, int n) {
+              for (int k = 0; k < n; ++k) {
+                  y[k] = vector_t<3> { x[k][1], 1.0, 0.0 };
+              }
+          }) });
+    auto jacobiansBatch = mito::jacobian(fieldBatch)(points3D);
+    auto divergencesBatch = mito::div(fieldBatch)(points3D);
+    for (int k = 0; k < (int) points3D.size(); ++k) {
+        assert(jacobiansBatch[k] == jacobians[k]);
+        assert(divergencesBatch[k] == 0.0);
+    }
+
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,85 @@
+#include <filesystem>
+#include <fstream>
+#include "../../mito.h"
+#include "../../mesh/Mesh.h"
+#include "../../mesh/ElementSet.h"
+#include "../../mesh/StructuredMeshFile.h"
+
+// the element set of the square (i, j) of a grid of n x n squares: the squares of the columns
+// 0, 3, 6, ... in set "steel", those of the columns 1, 4, 7, ... in set "rubber" and the others in
+// set "air"
+std::string
+material(int i, int)
+{
+    const char * materials[3] = { "steel", "rubber", "air" };
+    return materials[i % 3];
+}
+
+int
+main()
+{
+    // a mesh of the unit square in three element sets
+    int n = 6;
+    auto label = [n](const mito::point_t<2> & x) { return material(int(x[0] * n), 0); };
+    mito::writeStructuredMesh("square.summit", n, false, label);
+    mito::Mesh<2> mesh("square.summit");
+    int N = mesh.nEntities<2>();
+    assert(N == 2 * n * n);
+
+    // the element sets are named in order of appearance
+    assert(mesh.labels().size() == 3);
+    assert(mesh.label("steel") == 0 && mesh.label("rubber") == 1 && mesh.label("air") == 2);
+    assert(mesh.label("copper") == -1);
+
+    // each element is in the element set of its square, and the elements of each element set are
+    // those of its label, in increasing order
+    int total = 0;
+    for (int label = 0; label < 3; ++label) {
+        auto indices = mesh.elementIndices(label);
+        assert(int(indices.size()) == 2 * n * n / 3);
+        assert(std::is_sorted(indices.begin(), indices.end()));
+        for (auto e : indices) {
+            assert(mesh.elementLabels()[e] == label);
+        }
+        total += indices.size();
+    }
+    assert(total == N);
+    for (int e = 0; e < N; ++e) {
+        int i = (e / 2) % n;
+        int j = (e / 2) / n;
+        assert(mesh.labels()[mesh.elementLabels()[e]] == material(i, j));
+    }
+
+    // the element sets of the regions cover the square, a third each
+    mito::real area = 0.0;
+    for (int label = 0; label < 3; ++label) {
+        auto elements = mesh.elements(label);
+        for (int k = 0; k < int(elements.size()); ++k) {
+            assert(elements[k] == mesh.entities<2>()[mesh.elementIndices(label)[k]]);
+        }
+        mito::ElementSet region(
+            std::move(elements), mesh.elementsVertices(label), mesh.coordinates());
+        mito::real regionArea = 0.0;
+        for (int e = 0; e < region.nElements(); ++e) {
+            regionArea += region.jacobian(e);
+        }
+        assert(std::abs(regionArea - 1.0 / 3.0) < 1.e-14);
+        area += regionArea;
+    }
+    assert(std::abs(area - 1.0) < 1.e-14);
+
+    // the element sets survive the binary format
+    mito::convertMesh<2>("square.summit", "square.mito");
+    mito::Mesh<2> binary("square.mito");
+    std::filesystem::remove("square.summit");
+    std::filesystem::remove("square.mito");
+    assert(binary.labels() == mesh.labels());
+    assert(binary.elementLabels() == mesh.elementLabels());
+    for (int label = 0; label < 3; ++label) {
+        assert(std::ranges::equal(binary.elementIndices(label), mesh.elementIndices(label)));
+    }
+
+    return 0;
+}
+
+// end of file
@@ -1,4 +1,6 @@
 #include "../../math/Function.h"
+#include "../../math/StaticFunction.h"
+#include "../../math/Field.h"
 #include <cmath>
 
 using mito::Function;
@@ -89,5 +91,80 @@ main()
     std::cout << "function16 = " << function16(x) << std::endl;
     std::cout << "function17 = " << function18(x) << std::endl;
 
+    // static functions: compositions keep the concrete callable types
+    auto static1 = mito::function<mito::vector_t<2>>(
+        [](const mito::vector_t<2> & x) { return cos(x[0] * x[1]); });
+    auto static2 =
+        mito::function<mito::vector_t<2>>([](const mito::vector_t<2> & x) { return 5.0; });
+    static_assert(mito::static_function<decltype(static1 + static2)>);
+
+    auto static3 = (2.0 * static1 * static2 - static2 / 3.0) / static1;
+    auto function19 = (2.0 * function1 * function2 - function2 / 3.0) / function1;
+    assert(std::fabs(static3(x) - function19(x)) < TOL);
+
+    auto static4 = (PI + static1) - (2.0 * PI) - 1.0 / static2;
+    assert(std::fabs(static4(x) - (static1(x) - PI - 0.2)) < TOL);
+
+    auto static5 = mito::function<mito::vector_t<2>>([](const mito::vector_t<2> & x) {
+        return mito::vector_t<3> { cos(x[0] * x[1]), 1.0, x[0] };
+    });
+    auto static6 = -(alpha * static5 + static5 * static1);
+    assert(static6(x) == -(alpha * static5(x) + static5(x) * static1(x)));
+    assert(static6[2](x) == -(alpha + static1(x)) * x[0]);
+
+    // type-erase a static function at an API boundary
+    Function<mito::vector_t<2>> function20(static3);
+    assert(function20(x) == static3(x));
+    mito::ScalarField<2> field(static3);
+    assert(field(x) == static3(x));
+
+    // a function with a batch functor, evaluated at contiguous points
+    Function<mito::vector_t<2>> function21(
+        [](const mito::vector_t<2> * x, mito::scalar_t<mito::real> * y, int n) {
+            for (int k = 0; k < n; ++k) {
+                y[k] = cos(x[k][0] * x[k][1]);
+            }
+        });
+    assert(function21(x) == function1(x));
+
+    // batch evaluation of compositions agrees with pointwise evaluation (on more points than
+    // the size of a batch)
+    std::vector<mito::vector_t<2>> points(3 * mito::batch_size + 1);
+    for (int k = 0; k < (int) points.size(); ++k) {
+        points[k] = mito::vector_t<2> { 0.01 * k, 1.0 - 0.02 * k };
+    }
+    mito::ScalarField<2> field2((2.0 * function21 * function2 - function2 / 3.0) / function1);
+    auto values = field2(points);
+    for (int k = 0; k < (int) points.size(); ++k) {
+        assert(std::fabs(values[k] - function19(points[k])) < TOL);
+    }
+
+    // batch evaluation of the gradient and of the divergence
+    mito::ScalarField<2> field3(
+        function21, { Function<mito::vector_t<2>>([](const mito::vector_t<2> & x) {
+                          return -sin(x[0] * x[1]) * x[1];
+                      }),
+                      Function<mito::vector_t<2>>([](const mito::vector_t<2> & x) {
+                          return -sin(x[0] * x[1]) * x[0];
+                      }) });
+    auto gradient = mito::grad(field3);
+    auto gradients = gradient(points);
+    for (int k = 0; k < (int) points.size(); ++k) {
+        assert(gradients[k] == mito::grad(field3, points[k]));
+    }
+    using vector_function_t = Function<mito::vector_t<2>, mito::vector_t<2>>;
+    mito::VectorField<2, 2> field4(
+        vector_function_t(
+            [](const mito::vector_t<2> & x) { return mito::vector_t<2> { x[0] * x[1], x[1] }; }),
+        { vector_function_t(
+              [](const mito::vector_t<2> & x) { return mito::vector_t<2> { x[1], 0.0 }; }),
+          vector_function_t(
+              [](const mito::vector_t<2> & x) { return mito::vector_t<2> { x[0], 1.0 }; }) });
+    auto divergence = mito::div(field4);
+    auto divergences = divergence(points);
+    for (int k = 0; k < (int) points.size(); ++k) {
+        assert(divergences[k] == mito::div(field4, points[k]));
+    }
+
     return 0;
 }
\ No newline at end of file
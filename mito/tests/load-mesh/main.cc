@@ -1,6 +1,7 @@
 #include "../../mito.h"
 #include "../../mesh/Simplex.h"
 #include "../../mesh/Mesh.h"
+#include <filesystem>
 #include <fstream>
 #include <string>
 #include <map>
@@ -148,6 +149,115 @@ main()
     mito::Mesh<2> mesh("rectangle.summit");
     std::cout << "Loaded mesh (without repeated entities) in " << clock() - t << std::endl;
 
+    // each edge is shared by its triangles: by Euler's formula, a triangulation of a rectangle
+    // has V + F - 1 edges
+    assert(mesh.nEntities<1>() == mesh.nEntities<0>() + mesh.nEntities<2>() - 1);
+
+    // the topology as indices: each triangle is a coface of its edges, each edge bounds one or
+    // two triangles, and each triangle has three distinct vertices
+    const auto & topology = mesh.topology();
+    for (int e = 0; e < topology.nEntities<2>(); ++e) {
+        for (auto edge : topology.composition<2>(e)) {
+            auto cofaces = topology.cofaces<1>(edge);
+            assert(std::find(cofaces.begin(), cofaces.end(), e) != cofaces.end());
+        }
+        auto vertices = topology.vertices<2>(e);
+        assert(vertices[0] < vertices[1] && vertices[1] < vertices[2]);
+    }
+    for (int edge = 0; edge < topology.nEntities<1>(); ++edge) {
+        assert(topology.cofaces<1>(edge).size() == 1 || topology.cofaces<1>(edge).size() == 2);
+    }
+
+    // the indices number the entities in the order of the mesh
+    int e = 0;
+    for (const auto & triangle : mesh.entities<2>()) {
+        int k = 0;
+        for (auto edge : topology.composition<2>(e)) {
+            assert(mesh.entities<1>()[edge] == triangle->entities()[k++]);
+        }
+        std::set<const mito::vertex_t *> vertices;
+        triangle->getVertices(vertices);
+        k = 0;
+        for (const auto & vertex : vertices) {
+            assert(mesh.entities<0>()[topology.vertices<2>(e)[k++]] == vertex);
+        }
+        ++e;
+    }
+
+    // the mesh file parsed in parallel is the mesh file parsed serially
+    mito::ThreadPool serial(1);
+    mito::ThreadPool pool(3);
+    mito::SummitFile<2> file("rectangle.summit", serial);
+    mito::SummitFile<2> parallelFile("rectangle.summit", pool);
+    assert(file.good() && parallelFile.good());
+    assert(file.nVertices() == mesh.nEntities<0>() && file.nElements() == mesh.nEntities<2>());
+    for (int v = 0; v < file.nVertices(); ++v) {
+        assert(std::ranges::equal(file.coordinates(v), parallelFile.coordinates(v)));
+        assert(file.coordinates(v)[0] == mesh.coordinates()[v][0]);
+        assert(file.coordinates(v)[1] == mesh.coordinates()[v][1]);
+    }
+    for (int e = 0; e < file.nElements(); ++e) {
+        assert(file.type(e) == 3 && parallelFile.type(e) == 3);
+        assert(std::ranges::equal(file.vertices(e), parallelFile.vertices(e)));
+        assert(file.label(e) == parallelFile.label(e));
+    }
+
+    // malformed mesh files are reported
+    auto parses = [&pool](const std::string & text) {
+        std::ofstream("malformed.summit") << text;
+        mito::SummitFile<2> file("malformed.summit", pool);
+        std::filesystem::remove("malformed.summit");
+        return file.good();
+    };
+    assert(parses("2\n3 1 1\n0 0\n1 0\n\n0 1\n3 1 2 3 A\n"));
+    assert(!parses("2\n3 1 1\n0 0\n1 x\n0 1\n3 1 2 3 A\n"));
+    assert(!parses("2\n3 1 1\n0 0\n1 0\n0 1\n3 1 2 4 A\n"));
+    assert(!parses("2\n3 1 1\n0 0\n1 0\n0 1\n3 1 2 3\n"));
+    assert(!parses("2\n3 1 1\n0 0\n1 0\n0 1\n"));
+    assert(!parses("3\n3 1 1\n0 0 0\n1 0 0\n0 1 0\n3 1 2 3 A\n"));
+
+    // the mesh written in the binary format and loaded back is the same mesh
+    mito::convertMesh<2>("rectangle.summit", "rectangle.mito");
+    assert(mito::isBinaryMesh("rectangle.mito") && !mito::isBinaryMesh("rectangle.summit"));
+    t = clock();
+    mito::Mesh<2> binary("rectangle.mito");
+    std::cout << "Loaded binary mesh in " << clock() - t << std::endl;
+    assert(binary.nEntities<0>() == mesh.nEntities<0>());
+    assert(binary.nEntities<1>() == mesh.nEntities<1>());
+    assert(binary.nEntities<2>() == mesh.nEntities<2>());
+    assert(binary.coordinates().points() == mesh.coordinates().points());
+    assert(std::ranges::equal(
+        binary.topology().compositions<1>(), mesh.topology().compositions<1>()));
+    assert(std::ranges::equal(
+        binary.topology().compositions<2>(), mesh.topology().compositions<2>()));
+    assert(binary.labels() == mesh.labels() && binary.labels().size() == 1);
+    assert(binary.elementLabels() == mesh.elementLabels());
+    for (int e = 0; e < binary.nEntities<2>(); ++e) {
+        assert(binary.topology().vertices<2>(e) == mesh.topology().vertices<2>(e));
+    }
+
+    // a truncated binary mesh is rejected
+    mito::binary_mesh_header_t header;
+    std::ifstream("rectangle.mito", std::ios::binary)
+        .read(reinterpret_cast<char *>(&header), sizeof(header));
+    std::size_t size = std::filesystem::file_size("rectangle.mito");
+    assert(mito::checkBinaryMesh(header, 2, size));
+    assert(!mito::checkBinaryMesh(header, 2, size - 1));
+    assert(!mito::checkBinaryMesh(header, 3, size));
+
+    // so are names of element sets running past their bytes
+    std::vector<std::string> labels;
+    std::string names = binary.labels()[0];
+    names += '\0';
+    assert(mito::readBinaryMeshLabels(header, names.data(), labels) && labels == binary.labels());
+    auto corrupted = header;
+    corrupted.nLabels = 3;
+    assert(!mito::readBinaryMeshLabels(corrupted, names.data(), labels));
+    corrupted = header;
+    corrupted.labelBytes = 1;
+    assert(!mito::readBinaryMeshLabels(corrupted, names.data(), labels));
+    std::filesystem::remove("rectangle.mito");
+
     //
     t = clock();
     LoadMesh<2>("rectangle.summit");
@@ -0,0 +1,74 @@
+#include <filesystem>
+#include <fstream>
+#include "../../mito.h"
+#include "../../mesh/Mesh.h"
+#include "../../mesh/ElementSet.h"
+#include "../../mesh/StructuredMeshFile.h"
+
+int
+main()
+{
+    // a tetrahedral mesh of the unit cube
+    int n = 3;
+    mito::writeStructuredTetMesh("cube.summit", n);
+    mito::Mesh<3> mesh("cube.summit");
+
+    // the number of entities of each dimension
+    int V = mesh.nEntities<0>();
+    int E = mesh.nEntities<1>();
+    int F = mesh.nEntities<2>();
+    int T = mesh.nEntities<3>();
+    assert(V == (n + 1) * (n + 1) * (n + 1));
+    assert(T == 6 * n * n * n);
+    // each interior face is shared by two tetrahedra, and each boundary face (two per square on
+    // the boundary of the cube) belongs to one
+    assert(2 * F == 4 * T + 12 * n * n);
+    // Euler's formula for a ball
+    assert(V - E + F - T == 1);
+
+    // the topology as indices: each face bounds one or two tetrahedra, and each tetrahedron has
+    // four distinct vertices
+    const auto & topology = mesh.topology();
+    for (int f = 0; f < F; ++f) {
+        assert(topology.cofaces<2>(f).size() == 1 || topology.cofaces<2>(f).size() == 2);
+    }
+    for (int t = 0; t < T; ++t) {
+        auto vertices = topology.vertices<3>(t);
+        assert(std::adjacent_find(vertices.begin(), vertices.end(), std::greater_equal<int>())
+               == vertices.end());
+        for (auto face : topology.composition<3>(t)) {
+            auto cofaces = topology.cofaces<2>(face);
+            assert(std::find(cofaces.begin(), cofaces.end(), t) != cofaces.end());
+        }
+    }
+
+    // the tetrahedra fill the cube
+    mito::ElementSet elements(mesh.entities<3>(), mesh.elementsVertices(), mesh.coordinates());
+    mito::real volume = 0.0;
+    for (int t = 0; t < elements.nElements(); ++t) {
+        assert(std::abs(elements.jacobian(t) - 1.0 / (6 * n * n * n)) < 1.e-15);
+        volume += elements.jacobian(t);
+    }
+    assert(std::abs(volume - 1.0) < 1.e-12);
+
+    // the mesh written in the binary format and loaded back is the same mesh
+    mito::convertMesh<3>("cube.summit", "cube.mito");
+    mito::Mesh<3> binary("cube.mito");
+    std::filesystem::remove("cube.summit");
+    std::filesystem::remove("cube.mito");
+    assert(binary.nEntities<1>() == E && binary.nEntities<2>() == F && binary.nEntities<3>() == T);
+    for (int t = 0; t < T; ++t) {
+        assert(binary.topology().vertices<3>(t) == topology.vertices<3>(t));
+    }
+
+    // a tetrahedron is parsed in a two-dimensional file too (the mesh reports its type as unknown)
+    std::ofstream("tetrahedron.summit") << "2\n4 1 1\n0 0\n1 0\n0 1\n1 1\n4 1 2 3 4 A\n";
+    mito::ThreadPool pool(1);
+    mito::SummitFile<2> file("tetrahedron.summit", pool);
+    std::filesystem::remove("tetrahedron.summit");
+    assert(file.good() && file.type(0) == 4 && file.vertices(0).size() == 4);
+
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,164 @@
+#include <filesystem>
+#include <fstream>
+#include "../../mito.h"
+#include "../../mesh/Mesh.h"
+#include "../../mesh/ElementSet.h"
+#include "../../mesh/StructuredMeshFile.h"
+
+// the element set of the triangles with their centroid at {x}: "left" or "right" of x = 1/2
+std::string
+material(const mito::point_t<2> & x)
+{
+    return x[0] < 0.5 ? "left" : "right";
+}
+
+// lexicographic order of points
+bool
+less(const mito::point_t<2> & a, const mito::point_t<2> & b)
+{
+    return a[0] < b[0] || (a[0] == b[0] && a[1] < b[1]);
+}
+
+// the centroid of element {e} of {mesh}
+mito::point_t<2>
+centroid(const mito::Mesh<2> & mesh, int e)
+{
+    mito::point_t<2> centroid = { 0.0, 0.0 };
+    for (auto v : mesh.topology().vertices<2>(e)) {
+        centroid[0] += mesh.coordinates()[v][0] / 3.0;
+        centroid[1] += mesh.coordinates()[v][1] / 3.0;
+    }
+    return centroid;
+}
+
+// the sum of the distances between the centroids of consecutive elements of {mesh}
+mito::real
+path(const mito::Mesh<2> & mesh)
+{
+    mito::real path = 0.0;
+    for (int e = 1; e < mesh.nEntities<2>(); ++e) {
+        auto a = centroid(mesh, e - 1);
+        auto b = centroid(mesh, e);
+        path += std::hypot(a[0] - b[0], a[1] - b[1]);
+    }
+    return path;
+}
+
+// assert that the Hilbert curve through the D-dimensional cube of side 2^bits visits each cell
+// once, going from a cell to a neighboring one
+template <int D>
+void
+checkHilbertCurve(int bits)
+{
+    int side = 1 << bits;
+    int N = 1;
+    for (int d = 0; d < D; ++d) {
+        N *= side;
+    }
+
+    // the cell at each index along the curve
+    std::vector<std::array<std::uint32_t, D>> cells(N);
+    std::vector<char> visited(N, false);
+    for (int n = 0; n < N; ++n) {
+        std::array<std::uint32_t, D> cell;
+        for (int d = 0, m = n; d < D; ++d, m /= side) {
+            cell[d] = m % side;
+        }
+        std::uint64_t index = mito::hilbertIndex<D>(cell, bits);
+        assert(index < std::uint64_t(N) && !visited[index]);
+        visited[index] = true;
+        cells[index] = cell;
+    }
+
+    // consecutive cells are neighbors
+    for (int n = 1; n < N; ++n) {
+        int distance = 0;
+        for (int d = 0; d < D; ++d) {
+            distance += std::abs(int(cells[n][d]) - int(cells[n - 1][d]));
+        }
+        assert(distance == 1);
+    }
+
+    // all done
+    return;
+}
+
+int
+main()
+{
+    // the Hilbert curve
+    checkHilbertCurve<2>(1);
+    checkHilbertCurve<2>(4);
+    checkHilbertCurve<3>(3);
+
+    // a shuffled mesh of the unit square, in the order of the file and along the Hilbert curve
+    int n = 32;
+    mito::writeStructuredMesh("square.summit", n, true /* shuffle */, material);
+    mito::Mesh<2> mesh("square.summit");
+    mito::Mesh<2> ordered("square.summit", mito::Ordering::hilbert);
+    int N = mesh.nEntities<2>();
+
+    // the same mesh...
+    assert(ordered.nEntities<0>() == mesh.nEntities<0>());
+    assert(ordered.nEntities<1>() == mesh.nEntities<1>());
+    assert(ordered.nEntities<2>() == N);
+    auto points = mesh.coordinates().points();
+    auto orderedPoints = ordered.coordinates().points();
+    std::sort(points.begin(), points.end(), less);
+    std::sort(orderedPoints.begin(), orderedPoints.end(), less);
+    assert(points == orderedPoints);
+    // (the centroids of the triangles, at thirds of the grid spacing)
+    std::vector<std::pair<long, long>> centroids;
+    std::vector<std::pair<long, long>> orderedCentroids;
+    for (int e = 0; e < N; ++e) {
+        auto x = centroid(mesh, e);
+        auto y = centroid(ordered, e);
+        centroids.emplace_back(std::lround(3 * n * x[0]), std::lround(3 * n * x[1]));
+        orderedCentroids.emplace_back(std::lround(3 * n * y[0]), std::lround(3 * n * y[1]));
+    }
+    std::ranges::sort(centroids);
+    std::ranges::sort(orderedCentroids);
+    assert(centroids == orderedCentroids);
+    mito::ElementSet elements(
+        ordered.entities<2>(), ordered.elementsVertices(), ordered.coordinates());
+    mito::real area = 0.0;
+    for (int e = 0; e < elements.nElements(); ++e) {
+        assert(std::abs(elements.jacobian(e) - 0.5 / (n * n)) < 1.e-15);
+        area += elements.jacobian(e);
+    }
+    assert(std::abs(area - 1.0) < 1.e-12);
+
+    // ... with the labels following the elements
+    assert(ordered.labels().size() == 2);
+    for (int e = 0; e < N; ++e) {
+        assert(ordered.labels()[ordered.elementLabels()[e]] == material(centroid(ordered, e)));
+    }
+    for (int label = 0; label < 2; ++label) {
+        assert(int(ordered.elementIndices(label).size()) == n * n);
+    }
+
+    // ... with consecutive elements next to each other, and their vertices numbered in order
+    assert(path(ordered) < 1.1 * N / n);
+    assert(path(mesh) > 10.0 * path(ordered));
+    for (int e = 0, vertices = 0; e < N; ++e) {
+        for (auto v : ordered.topology().vertices<2>(e)) {
+            assert(v <= vertices);
+            vertices = std::max(vertices, v + 1);
+        }
+    }
+
+    // the ordered mesh written in the binary format is loaded back in its order
+    mito::convertMesh<2>("square.summit", "square.mito", mito::Ordering::hilbert);
+    mito::Mesh<2> binary("square.mito");
+    std::filesystem::remove("square.summit");
+    std::filesystem::remove("square.mito");
+    assert(binary.coordinates().points() == ordered.coordinates().points());
+    assert(binary.elementLabels() == ordered.elementLabels());
+    for (int e = 0; e < N; ++e) {
+        assert(binary.topology().vertices<2>(e) == ordered.topology().vertices<2>(e));
+    }
+
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,61 @@
+#include <cmath>
+#include "../../math/Field.h"
+#include "../../parallel/ThreadPool.h"
+
+using mito::vector_t;
+using mito::real;
+
+int
+main()
+{
+    // a parallel loop visits each index exactly once
+    for (int threads : { 1, 2, 3, 4 }) {
+        mito::ThreadPool pool(threads);
+        assert(pool.threads() == threads);
+        std::vector<int> visits(1000, 0);
+        for (int loop = 0; loop < 3; ++loop) {
+            pool.parallel_for(visits.size(), 7, [&](int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    ++visits[i];
+                }
+            });
+        }
+        for (auto v : visits) {
+            assert(v == 3);
+        }
+    }
+
+    // the points of a quadrature field (spanning several chunks)
+    constexpr int Q = 3;
+    int nElements = 5000;
+    mito::quadrature_field_t<Q, vector_t<2>> points(nElements);
+    std::vector<vector_t<2>> nodes(Q * nElements);
+    for (int e = 0; e < nElements; ++e) {
+        for (int q = 0; q < Q; ++q) {
+            points(e, q) = vector_t<2> { 0.001 * e, 0.1 * q };
+            nodes[e * Q + q] = points(e, q);
+        }
+    }
+
+    // a field
+    mito::VectorField<2, 2> field(mito::Function<vector_t<2>, vector_t<2>>(
+        [](const vector_t<2> & x) { return vector_t<2> { cos(x[0] * x[1]), x[0] * x[0] }; }));
+    auto serial = field(points);
+    auto serialAtNodes = field(nodes);
+
+    // the values evaluated in parallel are those evaluated serially, whatever the number of threads
+    for (int threads : { 1, 2, 3, 4 }) {
+        mito::ThreadPool pool(threads);
+        auto values = field(points, pool);
+        for (int e = 0; e < nElements; ++e) {
+            for (int q = 0; q < Q; ++q) {
+                assert(values(e, q) == serial(e, q));
+            }
+        }
+        assert(field(nodes, pool) == serialAtNodes);
+    }
+
+    return 0;
+}
+
+// end of file
@@ -177,6 +177,42 @@ main()
               << ", Error = " << std::fabs(result - 1.0 / 3.0) << std::endl;
     assert(std::fabs(result - 1.0 / 3.0) < 1.e-16);
 
+    // mixed precision: evaluate in single precision, accumulate in double precision
+    mito::Integrator<
+        GAUSS, 2 /* degree of exactness */, mito::ElementSet<mito::triangle_t, 2>, float>
+        bodyIntegratorFloat(bodyElementSet);
+    mito::ScalarField<2, float> f_cosine_float(
+        [](const vector_t<2, float> & x) { return std::cos(x[0] * x[1]); });
+    mito::scalar_t<real> resultFloat = bodyIntegratorFloat.integrate(f_cosine_float);
+    std::cout << "Mixed precision integration of cos(x*y): Result = " << resultFloat
+              << ", Error = " << std::fabs(resultFloat - bodyIntegrator.integrate(f_cosine))
+              << std::endl;
+    assert(std::fabs(resultFloat - bodyIntegrator.integrate(f_cosine)) < 1.e-6);
+
+    // memoization of the values of the fields at the quadrature points
+    int evaluations = 0;
+    mito::ScalarField<2> counted(
+        mito::functor<vector_t<2>, mito::scalar_t<real>>([&evaluations](const vector_t<2> & x) {
+            ++evaluations;
+            return x[0] * x[1];
+        }));
+    bodyIntegrator.memoize();
+    result = bodyIntegrator.integrate(counted);
+    int evaluationsPerIntegral = evaluations;
+    // integrating again the field (or a copy) costs no evaluation, and gives the same result
+    mito::ScalarField<2> copy(counted);
+    assert(bodyIntegrator.integrate(counted) == result);
+    assert(bodyIntegrator.integrate(copy) == result);
+    assert(evaluations == evaluationsPerIntegral);
+    // updating the coordinates forgets the memoized values
+    bodyIntegrator.updateCoordinates();
+    assert(bodyIntegrator.integrate(counted) == result);
+    assert(evaluations == 2 * evaluationsPerIntegral);
+    // without memoization, the field is evaluated at each integration
+    bodyIntegrator.memoize(false);
+    assert(bodyIntegrator.integrate(counted) == result);
+    assert(evaluations == 3 * evaluationsPerIntegral);
+
     // attach different coordinates (3D coordinates to the same vertices as above)
     mito::VertexPointMap<3> vertexCoordinatesMap3D;
     point_t<3> point03D = { 0.0, 0.0, 0.0 };
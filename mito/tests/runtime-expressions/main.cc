@@ -0,0 +1,120 @@
+#include "../../math/ExpressionField.h"
+#include "../../math/Field.h"
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+using mito::Expression;
+using mito::real;
+
+static const real TOL = 1.e-15;
+
+int
+main()
+{
+    // points spanning several batches
+    constexpr int D = 3;
+    int n = 2 * mito::batch_size + 5;
+    std::vector<real> x(n * D);
+    for (int k = 0; k < n; ++k) {
+        x[k * D + 0] = 0.01 * k;
+        x[k * D + 1] = 1.0 - 0.02 * k;
+        x[k * D + 2] = 0.5;
+    }
+    real t = 0.7;
+
+    // a scalar expression of the coordinates and of time
+    Expression source("sin(x0) * t + x[1]^2 / (1 + exp(-x[2]))", D);
+    assert(source.valid() && source.components() == 1);
+    std::vector<real> y(n);
+    source(x.data(), t, y.data(), n);
+    for (int k = 0; k < n; ++k) {
+        const real * p = &x[k * D];
+        assert(std::fabs(y[k] - (sin(p[0]) * t + p[1] * p[1] / (1.0 + exp(-p[2])))) < TOL);
+    }
+
+    // operations on constants are folded
+    Expression constant("2 * pi * (3 - 1) / 4 + sqrt(4)", D);
+    assert(constant.instructions() == 0);
+    constant(x.data(), t, y.data(), 1);
+    assert(std::fabs(y[0] - (std::numbers::pi + 2.0)) < TOL);
+
+    // equal subexpressions are evaluated once (the sine, the product and the sum)
+    Expression shared("sin(x0 * x1) + cos(x1 * x0) * sin(x[0]*x[1])", D);
+    assert(shared.instructions() == 5);
+
+    // ... but not the operations whose result is not the same for all reals
+    Expression zero("x0 * 0 + (x1 - x1)", D);
+    assert(zero.instructions() == 3);
+    std::vector<real> special = { INFINITY, 1.0, 0.0 };
+    zero(special.data(), t, y.data(), 1);
+    assert(std::isnan(y[0]));
+
+    // vector expressions, with components separated by commas or by white spaces
+    Expression commas("[0, -1 * t, x[2]]", D);
+    Expression spaces("[0 -1*t x[2]]", D);
+    assert(commas.components() == 3 && spaces.components() == 3);
+    std::vector<real> y1(3 * n), y2(3 * n);
+    commas(x.data(), t, y1.data(), n);
+    spaces(x.data(), t, y2.data(), n);
+    for (int k = 0; k < n; ++k) {
+        assert(y1[3 * k] == 0.0 && y1[3 * k + 1] == -t && y1[3 * k + 2] == x[k * D + 2]);
+    }
+    assert(y1 == y2);
+    // ... where a sign followed by a space is still a binary operation
+    assert(Expression("[1 - 1 t]", D).components() == 2);
+
+    // invalid expressions
+    assert(!Expression("sin(x0", D).valid());
+    assert(!Expression("x[3]", D).valid());
+    assert(!Expression("foo(t)", D).valid());
+    assert(
+        Expression("foo(t)", D).message()
+        == "unknown function foo at position 3 in expression \"foo(t)\"");
+    assert(Expression("sin(x0)", D).message().empty());
+
+    // a field given by an expression, as a function of the points and of time
+    auto field = mito::expression<mito::vector_t<2>>("cos(x0 * x1) + t");
+    assert(field.dependence() == mito::TimeDependence::GENERAL);
+    std::vector<mito::vector_t<2>> points(n);
+    for (int k = 0; k < n; ++k) {
+        points[k] = mito::vector_t<2> { x[k * D + 0], x[k * D + 1] };
+    }
+    for (real time : { 0.0, 1.0, 2.5 }) {
+        // ... evaluated in batch, and at one point at a time
+        auto values = field(points, time);
+        for (int k = 0; k < n; ++k) {
+            real expected = cos(points[k][0] * points[k][1]) + time;
+            assert(std::fabs(values[k] - expected) < TOL);
+            assert(field(points[k], time) == values[k]);
+        }
+    }
+
+    // a field constant in time, evaluated in batch
+    auto velocity = mito::expression<mito::vector_t<2>, mito::vector_t<2>>("[0, 100 * x[0]]");
+    assert(velocity.dependence() == mito::TimeDependence::CONSTANT);
+    auto values = velocity.f()(points);
+    for (int k = 0; k < n; ++k) {
+        assert((values[k] == mito::vector_t<2> { 0.0, 100.0 * points[k][0] }));
+        assert((velocity(points[k], 1.0) == values[k]));
+    }
+
+    // invalid expressions and expressions with the wrong number of components are errors
+    auto fails = [](auto make) {
+        try {
+            make();
+        } catch (const std::invalid_argument &) {
+            return true;
+        }
+        return false;
+    };
+    assert(fails([] { mito::expression<mito::vector_t<2>>("sin(x0"); }));
+    assert(fails([] { mito::expression<mito::vector_t<2>>("x2"); }));
+    assert(fails([] { mito::expression<mito::vector_t<2>>("[x0, x1]"); }));
+    assert(fails([] { mito::expression<mito::vector_t<2>, mito::vector_t<2>>("[x0, x1, t]"); }));
+    assert(!fails([] { mito::expression<mito::vector_t<2>, mito::vector_t<2>>("[x0, x1]"); }));
+
+    return 0;
+}
+
+// end of file
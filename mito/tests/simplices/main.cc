@@ -64,9 +64,32 @@ main()
         }
     }
 
+    // the vertices are numbered in order of insertion, and their coordinates are stored by value
+    assert(vertexCoordinatesMap.size() == 5);
+    assert(vertexCoordinatesMap.index(&vertex3) == 3);
+    assert((vertexCoordinatesMap[3] == point_t<2> { 0.5, 0.5 }));
+    assert(&vertexCoordinatesMap[vertex2] == &vertexCoordinatesMap.points()[2]);
+
     // instantiate an ElementSet as a collection of simplices and a vertex-coordinates mapping.
     mito::ElementSet elementSet(elements, vertexCoordinatesMap);
 
+    // the coordinates of the vertices of each element are those of the map
+    for (int e = 0; e < elementSet.nElements(); ++e) {
+        std::set<const vertex_t *> vertices;
+        elements[e]->getVertices(vertices);
+        int v = 0;
+        for (const auto & vertex : vertices) {
+            assert(&elementSet.coordinatesVertex(e, v++) == &vertexCoordinatesMap[vertex]);
+        }
+        // each element is a quarter of the unit square
+        assert(std::abs(elementSet.jacobian(e) - 0.25) < 1.e-15);
+    }
+
+    // the vertices inserted after a lookup by address are looked up too
+    vertex_t vertex5;
+    assert(vertexCoordinatesMap.insert(vertex5, point_t<2> { 2.0, 2.0 }) == 5);
+    assert(vertexCoordinatesMap.index(&vertex5) == 5 && vertexCoordinatesMap.index(&vertex0) == 0);
+
     // all done
     return 0;
 }
@@ -0,0 +1,125 @@
+#include <cmath>
+#include "../../mito.h"
+#include "../../algebra/SymmetricTensor.h"
+#include "../../algebra/DiagonalTensor.h"
+
+using mito::real;
+
+static const real TOL = 1.e-14;
+
+template <class G1, class G2>
+bool
+close(const G1 & a, const G2 & b)
+{
+    for (int i = 0; i < G1::S; ++i) {
+        if (std::fabs(a[i] - b[i]) > TOL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int D>
+bool
+close(const mito::tensor_t<D> & A, const mito::sym_tensor_t<D> & B)
+{
+    return close(A, mito::tensor_t<D>(B));
+}
+
+int
+main()
+{
+    // only the independent entries are stored
+    static_assert(sizeof(mito::sym_tensor_t<3>) == 6 * sizeof(real));
+    static_assert(sizeof(mito::diag_tensor_t<3>) == 3 * sizeof(real));
+    static_assert(std::is_trivially_copyable_v<mito::sym_tensor_t<3>>);
+
+    // a symmetric tensor and its full counterpart
+    constexpr mito::sym_tensor_t<3> A = { 4.0, 1.0, 0.5, 3.0, -1.0, 2.0 };
+    constexpr mito::tensor_t<3> fullA = A;
+    static_assert(A(2, 1) == -1.0 && fullA[7] == -1.0 && fullA[5] == -1.0);
+    static_assert(mito::sym_tensor_t<3>(fullA)[4] == -1.0);
+
+    // trace, determinant and inverse against the full kernels
+    static_assert(mito::ComputeTrace(A) == 9.0);
+    assert(std::fabs(mito::ComputeDeterminant(A) - mito::ComputeDeterminant(fullA)) < TOL);
+    mito::sym_tensor_t<3> invA;
+    mito::tensor_t<3> fullInvA;
+    assert(std::fabs(mito::ComputeInverse(A, invA) - mito::ComputeInverse(fullA, fullInvA)) < TOL);
+    assert(close(fullInvA, invA));
+
+    mito::sym_tensor_t<2> A2 = { 2.0, 0.5, 3.0 };
+    mito::sym_tensor_t<2> invA2;
+    mito::tensor_t<2> fullInvA2;
+    mito::ComputeInverse(mito::tensor_t<2>(A2), fullInvA2);
+    assert(mito::ComputeInverse(A2, invA2) == 5.75);
+    assert(close(fullInvA2, invA2));
+
+    // beyond the closed forms
+    mito::sym_tensor_t<4> A4 = { 4.0, 1.0, 0.0, 0.5, 3.0, 0.0, 0.0, 2.0, 0.0, 1.0 };
+    mito::sym_tensor_t<4> invA4;
+    mito::tensor_t<4> fullInvA4;
+    mito::ComputeInverse(A4, invA4);
+    mito::ComputeInverse<4, real>(A4, fullInvA4);
+    assert(close(fullInvA4, invA4));
+
+    // contractions
+    mito::sym_tensor_t<3> B = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+    mito::tensor_t<3> fullB = B;
+    mito::vector_t<3> x = { 1.0, -1.0, 2.0 };
+    assert(close(A * x, fullA * x));
+    mito::tensor_t<3> AB = mito::dot(A, B);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            real ABij = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                ABij += fullA[i * 3 + k] * fullB[k * 3 + j];
+            }
+            assert(std::fabs(AB[i * 3 + j] - ABij) < TOL);
+        }
+    }
+    real AddotB = 0.0;
+    for (int k = 0; k < 9; ++k) {
+        AddotB += fullA[k] * fullB[k];
+    }
+    assert(mito::ddot(A, B) == AddotB);
+    assert(close(mito::tensor_t<3>(fullA - fullB), A + B - 2.0 * B));
+
+    // C = F^T F
+    mito::tensor_t<3> F = { 1.0, 0.5, 0.0, 0.0, 1.0, 0.2, 0.1, 0.0, 1.0 };
+    mito::sym_tensor_t<3> C;
+    mito::ComputeTransposeProduct(F, C);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            real Cij = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                Cij += F[k * 3 + i] * F[k * 3 + j];
+            }
+            assert(std::fabs(C(i, j) - Cij) < TOL);
+        }
+    }
+
+    // diagonal tensors
+    constexpr mito::diag_tensor_t<3> L = { 2.0, 3.0, 4.0 };
+    static_assert(mito::ComputeTrace(L) == 9.0);
+    static_assert(mito::ComputeDeterminant(L) == 24.0);
+    mito::diag_tensor_t<3> invL;
+    assert(mito::ComputeInverse(L, invL) == 24.0);
+    assert(close(mito::dot(L, invL), mito::diag_tensor_t<3> { 1.0, 1.0, 1.0 }));
+    assert(close(L * x, mito::vector_t<3> { 2.0, -3.0, 8.0 }));
+    mito::tensor_t<3> fullL = L;
+    mito::tensor_t<3> LF = mito::dot(L, F);
+    mito::tensor_t<3> FL = mito::dot(F, L);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            assert(LF[i * 3 + j] == L[i] * F[i * 3 + j]);
+            assert(FL[i * 3 + j] == F[i * 3 + j] * L[j]);
+        }
+    }
+    assert(mito::ddot(L, A) == 2.0 * 4.0 + 3.0 * 3.0 + 4.0 * 2.0);
+    assert(mito::ddot(A, L) == mito::ddot(mito::sym_tensor_t<3>(L), A));
+    assert(close(mito::sym_tensor_t<3>(L), mito::sym_tensor_t<3>(fullL)));
+
+    // all done
+    return 0;
+}
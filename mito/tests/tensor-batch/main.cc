@@ -0,0 +1,80 @@
+#include <cmath>
+#include "../../mito.h"
+#include "../../algebra/TensorBatch.h"
+
+using mito::real;
+
+static const real TOL = 1.e-14;
+
+// a batch size that is not a multiple of the SIMD width, to exercise the remainder
+static constexpr int N = 13;
+
+template <class G1, class G2>
+bool
+close(const G1 & a, const G2 & b)
+{
+    for (int i = 0; i < G1::S; ++i) {
+        if (std::fabs(a[i] - b[i]) > TOL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int
+main()
+{
+    // fill batches of 2x2 and 3x3 tensors and of 3-vectors
+    mito::TensorBatch<2, 2, N> A2;
+    mito::TensorBatch<3, 3, N> A3;
+    mito::VectorBatch<3, N> x3;
+    for (int n = 0; n < N; ++n) {
+        A2.set(n, mito::tensor_t<2> { 2.0 + n, 1.0, 0.5, 3.0 });
+        A3.set(n, mito::tensor_t<3> { 4.0 + n, 1.0, 0.0, 1.0, 3.0, 0.5, 0.0, 0.5, 2.0 + n });
+        x3.set(n, mito::vector_t<3> { 1.0, -1.0 * n, 0.5 });
+    }
+
+    // determinants and inverses against the per-tensor kernels
+    mito::ScalarBatch<N> det2, det3;
+    mito::TensorBatch<2, 2, N> invA2;
+    mito::TensorBatch<3, 3, N> invA3;
+    mito::ComputeInverse(A2, invA2, det2);
+    mito::ComputeInverse(A3, invA3, det3);
+    for (int n = 0; n < N; ++n) {
+        mito::tensor_t<2> inv2;
+        mito::tensor_t<3> inv3;
+        assert(std::fabs(det2(n, 0) - mito::ComputeInverse(A2.get(n), inv2)) < TOL);
+        assert(std::fabs(det3(n, 0) - mito::ComputeInverse(A3.get(n), inv3)) < TOL);
+        assert(close(invA2.get(n), inv2));
+        assert(close(invA3.get(n), inv3));
+    }
+
+    // matrix-vector and matrix-matrix products against the per-tensor kernels
+    mito::VectorBatch<3, N> y3;
+    mito::ComputeProduct(A3, x3, y3);
+    mito::TensorBatch<3, 3, N> I3;
+    mito::ComputeProduct(A3, invA3, I3);
+    for (int n = 0; n < N; ++n) {
+        assert(close(y3.get(n), mito::vector_t<3>(A3.get(n) * x3.get(n))));
+        assert(close(I3.get(n), mito::tensor_t<3> { 1, 0, 0, 0, 1, 0, 0, 0, 1 }));
+    }
+
+    // transpose and trace
+    mito::TensorBatch<3, 3, N> AT3;
+    mito::ComputeTranspose(A3, AT3);
+    mito::ScalarBatch<N> trace3;
+    mito::ComputeTrace(A3, trace3);
+    for (int n = 0; n < N; ++n) {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                assert(AT3(n, i * 3 + j) == A3(n, j * 3 + i));
+            }
+        }
+        assert(trace3(n, 0) == A3(n, 0) + A3(n, 4) + A3(n, 8));
+    }
+
+    // all done
+    return 0;
+}
+
+// end of file
@@ -0,0 +1,115 @@
+#include <cmath>
+#include "../../math/TimeDependentField.h"
+
+using mito::vector_t;
+using mito::real;
+using mito::TimeDependence;
+
+static const real TOL = 1.e-15;
+
+// the number of evaluations of the spatial parts
+static int evaluations = 0;
+
+// a general field as a {mito::field}
+vector_t<2>
+traction(const vector_t<2> & x, real t)
+{
+    return vector_t<2> { x[0] * t, -t };
+}
+
+int
+main()
+{
+    // the nodes of a boundary
+    std::vector<vector_t<2>> nodes(10);
+    for (int a = 0; a < (int) nodes.size(); ++a) {
+        nodes[a] = vector_t<2> { 0.1 * a, 1.0 };
+    }
+
+    // the points of a quadrature field
+    constexpr int Q = 3;
+    mito::quadrature_field_t<Q, vector_t<2>> points(4);
+    for (int e = 0; e < 4; ++e) {
+        for (int q = 0; q < Q; ++q) {
+            points(e, q) = vector_t<2> { 0.1 * e, 0.2 * q };
+        }
+    }
+
+    // the spatial part, counting its evaluations
+    mito::ScalarField<2> f(mito::functor<vector_t<2>, mito::scalar_t<>>([](const vector_t<2> & x) {
+        ++evaluations;
+        return cos(x[0] * x[1]);
+    }));
+
+    // a field constant in time
+    mito::TimeDependentField<vector_t<2>> constant(f);
+    assert(constant.dependence() == TimeDependence::CONSTANT);
+    mito::CachedField constantAtNodes(constant, nodes);
+    evaluations = 0;
+    for (real t : { 0.0, 0.5, 1.0 }) {
+        const auto & values = constantAtNodes(t);
+        for (int a = 0; a < (int) nodes.size(); ++a) {
+            assert(values[a] == constant(nodes[a], t));
+        }
+    }
+    // the spatial part was only evaluated by the checks above
+    assert(evaluations == 3 * (int) nodes.size());
+
+    // a separable field: f(x) g(t)
+    mito::TimeDependentField<vector_t<2>> separable(f, [](real t) { return sin(t); });
+    assert(separable.dependence() == TimeDependence::SEPARABLE);
+    mito::CachedField separableAtPoints(separable, points);
+    evaluations = 0;
+    for (real t : { 0.0, 0.5, 1.0, 1.0 }) {
+        const auto & values = separableAtPoints(t);
+        for (int e = 0; e < 4; ++e) {
+            for (int q = 0; q < Q; ++q) {
+                assert(std::fabs(values(e, q) - sin(t) * cos(points(e, q)[0] * points(e, q)[1]))
+                       < TOL);
+            }
+        }
+    }
+    // the spatial part was cached at construction
+    assert(evaluations == 0);
+
+    // a general field
+    mito::TimeDependentField<vector_t<2>, vector_t<2>> general(traction);
+    assert(general.dependence() == TimeDependence::GENERAL);
+    mito::CachedField generalAtNodes(general, nodes);
+    for (real t : { 0.0, 0.5, 1.0 }) {
+        const auto & values = generalAtNodes(t);
+        for (int a = 0; a < (int) nodes.size(); ++a) {
+            assert(values[a] == traction(nodes[a], t));
+        }
+    }
+
+    // a general field evaluated in batch, counting its evaluations
+    int batches = 0;
+    mito::TimeDependentField<vector_t<2>, vector_t<2>> batched(
+        [&batches](const vector_t<2> * x, real t, vector_t<2> * y, int n) {
+            ++batches;
+            evaluations += n;
+            for (int i = 0; i < n; ++i) {
+                y[i] = traction(x[i], t);
+            }
+        });
+    assert(batched.dependence() == TimeDependence::GENERAL);
+    evaluations = 0;
+    mito::CachedField batchedAtPoints(batched, points);
+    // nothing is evaluated at construction...
+    assert(batches == 0 && evaluations == 0);
+    for (real t : { 0.5, 1.0, 1.0 }) {
+        const auto & values = batchedAtPoints(t);
+        for (int e = 0; e < 4; ++e) {
+            for (int q = 0; q < Q; ++q) {
+                assert(values(e, q) == traction(points(e, q), t));
+            }
+        }
+    }
+    // ... and the field is evaluated at all the points at once at each new time
+    assert(batches == 2 && evaluations == 2 * 4 * Q);
+
+    return 0;
+}
+
+// end of file
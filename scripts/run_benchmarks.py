@@ -0,0 +1,87 @@
+import json
+import os
+import shutil
+import subprocess
+import sys
+
+# Builds and runs every benchmark in mito/benchmarks and collects their measurements (one JSON
+# object per line on the standard output of each benchmark) in a single JSON file, to be compared
+# release to release. Usage: python3 run_benchmarks.py [output.json]
+
+
+def clean_up(folder):
+    shutil.rmtree(folder)
+
+
+root = sys.path[0] + "/"
+benchmarks_folder = root + "../mito/benchmarks/"
+if not os.path.isdir(benchmarks_folder):
+    raise NameError("Please check that benchmarks folder exists")
+
+# List of all folders
+folders = sorted([x for x in os.listdir(
+    benchmarks_folder) if os.path.isdir(benchmarks_folder + x)])
+
+output_file = sys.argv[1] if len(sys.argv) > 1 else root + 'benchmarks.json'
+
+# Environment
+pyre_dir = os.environ['PYRE_DIR']
+# optimization flags (e.g. add -march=native to benchmark the widest SIMD instruction set)
+flags = os.environ.get('MITO_BENCHMARK_FLAGS', '-O3 -DNDEBUG')
+
+# the revision being benchmarked
+revision = subprocess.run('git -C ' + root + ' rev-parse HEAD', capture_output=True, text=True,
+                          shell=True).stdout.strip()
+
+results = []
+failures = []
+for folder in folders:
+    folder_path = benchmarks_folder + folder + "/"
+    os.chdir(folder_path)
+    benchmark_name = "main"
+    benchmark_path = folder_path + benchmark_name
+    benchmark_ext = ".cc"
+    if not os.path.isfile(benchmark_path + benchmark_ext):
+        raise NameError("Please name the benchmark as main.cc")
+
+    # Temporary folder for compile and run the benchmark
+    tmp_folder_path = folder_path + "build_temp/"
+    if os.path.isdir(tmp_folder_path):
+        clean_up(tmp_folder_path)
+    os.mkdir(tmp_folder_path)
+
+    # Commands to execute
+    compile_cmd = 'g++ -std=c++2a -pthread ' + flags + ' ' + \
+        '-I' + pyre_dir + '/include -lpyre -ljournal -L' + pyre_dir + '/lib ' + \
+        benchmark_path + benchmark_ext + ' -o ' + tmp_folder_path + benchmark_name
+    run_cmd = tmp_folder_path + benchmark_name
+
+    compile_process = subprocess.run(
+        compile_cmd, capture_output=True, text=True, shell=True)
+    if compile_process.returncode != 0:
+        print(folder + ": FAIL (compilation error)\n" + compile_process.stderr)
+        failures.append(folder)
+        clean_up(tmp_folder_path)
+        continue
+
+    run_process = subprocess.run(
+        run_cmd, capture_output=True, text=True, shell=True)
+    if run_process.returncode != 0:
+        print(folder + ": FAIL (runtime error)\n" + run_process.stderr)
+        failures.append(folder)
+        clean_up(tmp_folder_path)
+        continue
+
+    # keep the measurements, skip any other output of the benchmark
+    for line in run_process.stdout.splitlines():
+        if line.startswith("{"):
+            results.append(json.loads(line))
+            print(line)
+
+    clean_up(tmp_folder_path)
+
+with open(output_file, 'w') as f:
+    json.dump({"revision": revision, "flags": flags, "results": results}, f, indent=1)
+
+print("All done, see file {} for the results.".format(output_file))
+sys.exit(1 if failures else 0)
@@ -48,7 +48,7 @@ with open(output_file, 'w') as f:
         os.mkdir(tmp_folder_path)
 
         # Commands to execute
-        compile_cmd = 'g++ -g -std=c++2a ' + \
+        compile_cmd = 'g++ -g -std=c++2a -pthread ' + \
             '-I' + pyre_dir + '/include -lpyre -ljournal -L' + pyre_dir + '/lib ' + \
             '-Wall -Wextra -pedantic -Werror ' + \
             '-Wno-unused-variable -Wno-unused-parameter ' + \